@@ -0,0 +1,146 @@
+#include "Benchmarks.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "BST.h"
+#include "Deque.h"
+#include "List.h"
+#include "PriorityQueue.h"
+#include "Queue.h"
+#include "Stack.h"
+#include "UnrolledList.h"
+
+static constexpr int VALUES = 100000;
+
+/*
+ * Every allocation of the DEMO 
+ * binary goes through these, so 
+ * the benchmark can count them. 
+ * A relaxed increment is noise 
+ * next to malloc itself.
+ */
+static std::atomic<std::size_t> sAllocations{0};
+
+void* operator new(std::size_t size) {
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+/*
+ * @brief a payload that owns heap 
+ *  memory, like a long string, and 
+ *  counts how often it's copied 
+ *  and moved
+ */
+struct Payload {
+    static std::size_t copies;
+    static std::size_t moves;
+
+    explicit Payload(int value) {
+        text.reserve(48);
+        text += std::to_string(static_cast<unsigned int>(value) * 2654435761u);
+        text.append(32, '.');
+    }
+    Payload(const Payload& other) : text(other.text) { ++copies; }
+    Payload(Payload&& other) noexcept : text(std::move(other.text)) { ++moves; }
+    Payload& operator=(const Payload& other) { text = other.text; ++copies; return *this; }
+    Payload& operator=(Payload&& other) noexcept { text = std::move(other.text); ++moves; return *this; }
+
+    bool operator<(const Payload& other) const { return text < other.text; }
+    bool operator>(const Payload& other) const { return text > other.text; }
+    bool operator==(const Payload& other) const { return text == other.text; }
+    bool operator!=(const Payload& other) const { return text != other.text; }
+
+    std::string text;
+};
+
+std::size_t Payload::copies = 0;
+std::size_t Payload::moves = 0;
+
+/*
+ * @brief runs a workload and prints 
+ *  its copies, moves and allocations 
+ *  per value
+ */
+template<typename Function>
+static void __measure__(const char* name, Function&& function) {
+    Payload::copies = Payload::moves = 0;
+    std::size_t allocations = sAllocations.load(std::memory_order_relaxed);
+    function();
+    allocations = sAllocations.load(std::memory_order_relaxed) - allocations;
+    std::cout << name << "\t" << static_cast<double>(Payload::copies) / VALUES 
+        << "\t" << static_cast<double>(Payload::moves) / VALUES 
+        << "\t" << static_cast<double>(allocations) / VALUES << "\n";
+}
+
+void alloc_benchmark(void) {
+    std::cout << VALUES << " payloads owning a 40+ character string, per value\n";
+    std::cout << "building a payload allocates once, everything above that is the container\n";
+    std::cout << "workload\t\t\tcopies\tmoves\tallocations\n";
+
+    __measure__("Stack push(lvalue) + pop\t", [] {
+        Stack<Payload> stack;
+        for (int i = 0; i < VALUES; ++i) {
+            Payload payload(i);
+            stack.push(payload);
+        }
+        while (!stack.isEmpty()) { do_not_optimize(stack.pop().text.size()); }
+    });
+    __measure__("Stack push(rvalue) + pop\t", [] {
+        Stack<Payload> stack;
+        for (int i = 0; i < VALUES; ++i)
+            stack.push(Payload(i));
+        while (!stack.isEmpty()) { do_not_optimize(stack.pop().text.size()); }
+    });
+    __measure__("Stack emplace + pop\t\t", [] {
+        Stack<Payload> stack;
+        stack.reserve(VALUES);
+        for (int i = 0; i < VALUES; ++i)
+            stack.emplace(i);
+        while (!stack.isEmpty()) { do_not_optimize(stack.pop().text.size()); }
+    });
+    __measure__("Queue emplace + dequeue\t", [] {
+        Queue<Payload> queue(VALUES);
+        for (int i = 0; i < VALUES; ++i)
+            queue.emplace(i);
+        while (!queue.isEmpty()) { do_not_optimize(queue.dequeue().text.size()); }
+    });
+    __measure__("Deque emplaceBack + popFront", [] {
+        Deque<Payload> deque;
+        for (int i = 0; i < VALUES; ++i)
+            deque.emplaceBack(i);
+        while (!deque.isEmpty()) { do_not_optimize(deque.popFront().text.size()); }
+    });
+    __measure__("List emplaceBack + popFront\t", [] {
+        List<Payload> list;
+        for (int i = 0; i < VALUES; ++i)
+            list.emplaceBack(i);
+        while (!list.isEmpty()) { do_not_optimize(list.popFront().text.size()); }
+    });
+    __measure__("UnrolledList emplaceBack\t", [] {
+        UnrolledList<Payload> list;
+        for (int i = 0; i < VALUES; ++i)
+            list.emplaceBack(i);
+        do_not_optimize(list.size());
+    });
+    __measure__("PriorityQueue emplace + pop\t", [] {
+        PriorityQueue<Payload> queue;
+        queue.reserve(VALUES);
+        for (int i = 0; i < VALUES; ++i)
+            queue.emplace(i);
+        while (!queue.isEmpty()) { do_not_optimize(queue.pop().text.size()); }
+    });
+    __measure__("BST insert(rvalue)\t\t", [] {
+        BST<Payload> tree;
+        for (int i = 0; i < VALUES; ++i)
+            tree.insert(Payload(i));
+    });
+}
@@ -0,0 +1,44 @@
+#include "Benchmarks.h"
+
+#include <iostream>
+
+/*
+ * @brief a single entry of 
+ *  the benchmark table
+ */
+struct Benchmark {
+    const char* name;
+    const char* description;
+    void (*run)(void);
+};
+
+static const Benchmark BENCHMARKS[] = {
+    { "list", "List vs UnrolledList build, find and remove", list_benchmark },
+    { "spsc", "SPSCQueue vs mutex-guarded Queue throughput and latency", spsc_benchmark },
+    { "stack", "ConcurrentStack vs mutex-guarded Stack with 1-64 threads", stack_benchmark },
+    { "mpmc", "MPMCQueue vs mutex-guarded Queue with 1-8 producers and consumers", mpmc_benchmark },
+    { "deque", "Deque vs std::deque sliding window, both ends and random access", deque_benchmark },
+    { "steal", "WorkStealingDeque correctness under contention and steal throughput", steal_benchmark },
+    { "alloc", "copies, moves and allocations per value pushed through the containers", alloc_benchmark },
+    { "pool", "BST and List on std::allocator vs PoolResource and ArenaResource", pool_benchmark },
+    { "bulk", "pushRange, popN and drainTo vs loops over single value calls", bulk_benchmark },
+    { "spill", "SpillQueue vs Queue building up and replaying a backlog past its memory budget", spill_benchmark },
+    { "window", "SlidingWindow rolling min and max vs rescanning the window", window_benchmark },
+    { "hash", "HashMap vs std::unordered_map and BST insert, lookup and remove", hash_benchmark },
+    { "intrusive", "IntrusiveList vs List push/pop and remove from the middle", intrusive_benchmark },
+    { "cache", "LRUCache vs std::list + unordered_map and sharded locking on Zipf traces", cache_benchmark },
+};
+
+bool run_benchmark(const std::string& name) {
+    for (const auto& benchmark : BENCHMARKS) {
+        if (name != benchmark.name) { continue; }
+        benchmark.run();
+        return true;
+    }
+    return false;
+}
+
+void list_benchmarks(void) {
+    for (const auto& benchmark : BENCHMARKS)
+        std::cout << "  " << benchmark.name << "\t" << benchmark.description << "\n";
+}
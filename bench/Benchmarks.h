@@ -0,0 +1,64 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <chrono>
+#include <string>
+
+/*
+ * @brief runs a benchmark by 
+ *  its name
+ *
+ * @param name name of the benchmark
+ *
+ * @return false if there's no 
+ *  benchmark with that name
+ */
+bool run_benchmark(const std::string& name);
+
+/*
+ * @brief prints the names of 
+ *  all of the benchmarks
+ */
+void list_benchmarks(void);
+
+/*
+ * @brief measures the wall 
+ *  clock time of a function
+ *
+ * @return elapsed time in 
+ *  milliseconds
+ */
+template<typename Function>
+double time_ms(Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    function();
+    std::chrono::duration<double, std::milli> elapsed = 
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/*
+ * @brief keeps the compiler from 
+ *  optimising a computed value away
+ */
+template<typename Type>
+void do_not_optimize(const Type& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+void list_benchmark(void);
+void spsc_benchmark(void);
+void stack_benchmark(void);
+void mpmc_benchmark(void);
+void deque_benchmark(void);
+void steal_benchmark(void);
+void alloc_benchmark(void);
+void pool_benchmark(void);
+void bulk_benchmark(void);
+void spill_benchmark(void);
+void window_benchmark(void);
+void hash_benchmark(void);
+void intrusive_benchmark(void);
+void cache_benchmark(void);
+
+#endif
@@ -0,0 +1,132 @@
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "List.h"
+#include "Queue.h"
+#include "Stack.h"
+#include "ThreadPool.h"
+
+static constexpr int VALUES = 10000000;
+static constexpr int BATCH = 64;
+static constexpr int RANGE = 1 << 24;
+
+/*
+ * @brief pushes batches through a stack, 
+ *  one value at a time or a batch at a time
+ */
+template<bool Bulk>
+double __stack__(void) {
+    std::vector<int> batch(BATCH, 1);
+    std::vector<int> out(BATCH);
+    return time_ms([&] {
+        Stack<int> stack;
+        long long sum = 0;
+        for (int round = 0; round < VALUES / BATCH; ++round) {
+            if constexpr (Bulk) {
+                stack.pushRange(batch);
+                stack.popN(out.data(), BATCH);
+            } else {
+                for (int i = 0; i < BATCH; ++i)
+                    stack.push(batch[i]);
+                for (int i = 0; i < BATCH; ++i)
+                    out[i] = stack.pop();
+            }
+            sum += out[round % BATCH];
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief streams batches through a queue 
+ *  that stays half full, so the copies 
+ *  keep crossing the wrap
+ */
+template<bool Bulk>
+double __queue__(void) {
+    std::vector<int> batch(BATCH, 1);
+    std::vector<int> out(BATCH);
+    return time_ms([&] {
+        Queue<int> queue;
+        for (int i = 0; i < 1000; ++i)
+            queue.enqueue(i);
+        long long sum = 0;
+        for (int round = 0; round < VALUES / BATCH; ++round) {
+            if constexpr (Bulk) {
+                queue.enqueueRange(batch);
+                queue.dequeueN(out.data(), BATCH);
+            } else {
+                for (int i = 0; i < BATCH; ++i)
+                    queue.enqueue(batch[i]);
+                for (int i = 0; i < BATCH; ++i)
+                    out[i] = queue.dequeue();
+            }
+            sum += out[round % BATCH];
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief fills a list and 
+ *  empties it into a vector
+ */
+template<bool Bulk>
+double __list__(void) {
+    std::vector<int> batch(BATCH, 1);
+    std::vector<int> out;
+    out.reserve(VALUES);
+    return time_ms([&] {
+        List<int> list;
+        for (int round = 0; round < VALUES / BATCH; ++round) {
+            if constexpr (Bulk) {
+                list.pushRange(batch);
+            } else {
+                for (int i = 0; i < BATCH; ++i)
+                    list.pushBack(batch[i]);
+            }
+        }
+        if constexpr (Bulk) {
+            list.drainTo(std::back_inserter(out));
+        } else {
+            while (!list.isEmpty())
+                out.push_back(list.popFront());
+        }
+        do_not_optimize(out.data());
+    });
+}
+
+/*
+ * @brief pushes one large range through 
+ *  a stack and a queue, growing them from 
+ *  empty, and takes it back out
+ */
+double __policy__(ExecutionPolicy policy) {
+    std::vector<int> values(RANGE, 1);
+    std::vector<int> out(RANGE);
+    return time_ms([&] {
+        Stack<int> stack;
+        stack.pushRange(policy, values);
+        stack.popN(policy, out.data(), RANGE);
+        Queue<int> queue;
+        queue.enqueueRange(policy, values);
+        queue.dequeueN(policy, out.data(), RANGE);
+        do_not_optimize(out.data());
+    });
+}
+
+void bulk_benchmark(void) {
+    std::cout << VALUES << " values in batches of " << BATCH << ", ms\n";
+    std::cout << "container\tsingle\tbulk\n";
+    std::cout << "Stack push/pop\t" << __stack__<false>() << "\t" << __stack__<true>() << "\n";
+    std::cout << "Queue enqueue/dequeue\t" << __queue__<false>() << "\t" << __queue__<true>() << "\n";
+    std::cout << "List push/drain\t" << __list__<false>() << "\t" << __list__<true>() << "\n";
+
+    std::cout << "\n" << RANGE << " values in one range through Stack and Queue, " 
+        << ThreadPool::instance().workerCount() << " workers, ms\n";
+    std::cout << "seq\tpar\n";
+    std::cout << __policy__(ExecutionPolicy::seq) << "\t" << __policy__(ExecutionPolicy::par) << "\n";
+}
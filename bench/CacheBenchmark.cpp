@@ -0,0 +1,155 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "LRUCache.h"
+
+static constexpr int KEYS = 1 << 20;
+static constexpr int OPERATIONS = 4000000;
+static constexpr double SKEW = 0.99;
+static constexpr int MAX_THREADS = 8;
+
+/*
+ * @brief draws keys with a Zipf 
+ *  distribution, rank r is picked 
+ *  with a probability proportional 
+ *  to 1 / r^SKEW. The ranks are 
+ *  scattered over the key space, so 
+ *  hot keys aren't neighbours
+ */
+std::vector<std::uint32_t> __zipf_trace__(int count, std::uint32_t seed) {
+    static std::vector<double> cdf;
+    if (cdf.empty()) {
+        cdf.resize(KEYS);
+        double sum = 0;
+        for (int rank = 0; rank < KEYS; ++rank) {
+            sum += 1.0 / std::pow(rank + 1, SKEW);
+            cdf[rank] = sum;
+        }
+        for (double& p : cdf)
+            p /= sum;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<std::uint32_t> trace(count);
+    for (auto& key : trace) {
+        auto rank = std::lower_bound(cdf.begin(), cdf.end(), uniform(rng)) - cdf.begin();
+        key = static_cast<std::uint32_t>(rank) * 2654435761u;
+    }
+    return trace;
+}
+
+/*
+ * @brief the usual LRU cache on 
+ *  std::list and std::unordered_map
+ */
+class StdLRU {
+public:
+    explicit StdLRU(std::size_t capacity) : mCapacity(capacity) { mIndex.reserve(capacity); }
+
+    int* get(std::uint32_t key) {
+        auto found = mIndex.find(key);
+        if (found == mIndex.end()) { return nullptr; }
+        mRecency.splice(mRecency.begin(), mRecency, found->second);
+        return &found->second->second;
+    }
+
+    void put(std::uint32_t key, int value) {
+        if (mRecency.size() == mCapacity) {
+            mIndex.erase(mRecency.back().first);
+            mRecency.pop_back();
+        }
+        mRecency.emplace_front(key, value);
+        mIndex.emplace(key, mRecency.begin());
+    }
+
+private:
+    std::size_t mCapacity;
+    std::list<std::pair<std::uint32_t, int>> mRecency;
+    std::unordered_map<std::uint32_t, std::list<std::pair<std::uint32_t, int>>::iterator> mIndex;
+};
+
+/*
+ * @brief replays the trace as a read-through 
+ *  cache, a miss is followed by a put
+ */
+template<typename Cache>
+double __single__(const std::vector<std::uint32_t>& trace, std::size_t capacity) {
+    Cache cache(capacity);
+    return time_ms([&] {
+        long long sum = 0;
+        for (std::uint32_t key : trace) {
+            if (int* value = cache.get(key)) { sum += *value; }
+            else { cache.put(key, static_cast<int>(key)); }
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief every thread replays its own 
+ *  trace against the shared cache
+ */
+double __shared__(const std::vector<std::vector<std::uint32_t>>& traces,
+        int threads, std::size_t capacity, std::size_t shards, double& hitRatio) {
+    ShardedLRUCache<std::uint32_t, int> cache(capacity, shards);
+    int perThread = OPERATIONS / threads;
+
+    double ms = time_ms([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                long long sum = 0;
+                int value;
+                for (int i = 0; i < perThread; ++i) {
+                    std::uint32_t key = traces[t][i];
+                    if (cache.get(key, value)) { sum += value; }
+                    else { cache.put(key, static_cast<int>(key)); }
+                }
+                do_not_optimize(sum);
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    });
+
+    CacheStats stats = cache.stats();
+    hitRatio = static_cast<double>(stats.hits) / static_cast<double>(stats.hits + stats.misses);
+    return ms;
+}
+
+void cache_benchmark(void) {
+    std::vector<std::vector<std::uint32_t>> traces;
+    for (int t = 0; t < MAX_THREADS; ++t)
+        traces.push_back(__zipf_trace__(OPERATIONS, 7 + t));
+
+    std::cout << OPERATIONS << " get-or-put on a Zipf(" << SKEW << ") trace over " 
+        << KEYS << " keys, M ops/s\n";
+    std::cout << "capacity\tstd::list+unordered_map\tLRUCache\n";
+    for (std::size_t capacity : { KEYS / 100, KEYS / 10 }) {
+        double list = __single__<StdLRU>(traces[0], capacity);
+        double lru = __single__<LRUCache<std::uint32_t, int>>(traces[0], capacity);
+        std::cout << capacity << "\t" << OPERATIONS / list / 1000.0 << "\t\t\t" 
+            << OPERATIONS / lru / 1000.0 << "\n";
+    }
+
+    std::size_t capacity = KEYS / 100;
+    std::cout << "\ncapacity " << capacity << ", M ops/s (hit ratio)\n";
+    std::cout << "threads\t1 shard\t\t16 shards\n";
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        double lockedHits, shardedHits;
+        double locked = __shared__(traces, threads, capacity, 1, lockedHits);
+        double sharded = __shared__(traces, threads, capacity, 16, shardedHits);
+        std::cout << threads << "\t" << OPERATIONS / locked / 1000.0 << " (" << lockedHits << ")\t" 
+            << OPERATIONS / sharded / 1000.0 << " (" << shardedHits << ")\n";
+    }
+}
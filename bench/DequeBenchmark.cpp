@@ -0,0 +1,101 @@
+#include "Benchmarks.h"
+
+#include <deque>
+#include <iostream>
+
+#include "Deque.h"
+
+static constexpr int OPERATIONS = 10000000;
+static constexpr int WINDOW = 4096;
+
+/*
+ * @brief adapts std::deque to the 
+ *  interface of Deque
+ */
+class StdDeque {
+public:
+    void pushBack(int value) { mDeque.push_back(value); }
+    void pushFront(int value) { mDeque.push_front(value); }
+    int popBack(void) { int value = mDeque.back(); mDeque.pop_back(); return value; }
+    int popFront(void) { int value = mDeque.front(); mDeque.pop_front(); return value; }
+    int& operator[](std::size_t idx) { return mDeque[idx]; }
+    std::size_t size(void) { return mDeque.size(); }
+
+private:
+    std::deque<int> mDeque;
+};
+
+/*
+ * @brief a fixed size window sliding 
+ *  over a stream of values
+ */
+template<typename Container>
+double __sliding_window__(void) {
+    return time_ms([] {
+        Container deque;
+        long long sum = 0;
+        for (int i = 0; i < WINDOW; ++i)
+            deque.pushBack(i);
+        for (int i = 0; i < OPERATIONS; ++i) {
+            deque.pushBack(i);
+            sum += deque.popFront();
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief grows and shrinks at both 
+ *  ends, the way an undo buffer 
+ *  with a history limit is used
+ */
+template<typename Container>
+double __both_ends__(void) {
+    return time_ms([] {
+        Container deque;
+        long long sum = 0;
+        for (int round = 0; round < OPERATIONS / (4 * WINDOW); ++round) {
+            for (int i = 0; i < WINDOW; ++i) {
+                deque.pushBack(i);
+                deque.pushFront(i);
+            }
+            for (int i = 0; i < WINDOW; ++i)
+                sum += deque.popBack() + deque.popFront();
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief strided reads across 
+ *  a large deque
+ */
+template<typename Container>
+double __random_access__(void) {
+    Container deque;
+    for (int i = 0; i < OPERATIONS / 10; ++i)
+        deque.pushBack(i);
+
+    return time_ms([&] {
+        long long sum = 0;
+        std::size_t size = deque.size();
+        std::size_t idx = 0;
+        for (int i = 0; i < OPERATIONS; ++i) {
+            sum += deque[idx];
+            idx += 7919;
+            if (idx >= size) { idx -= size; }
+        }
+        do_not_optimize(sum);
+    });
+}
+
+void deque_benchmark(void) {
+    std::cout << OPERATIONS << " operations, ms\n";
+    std::cout << "workload\tDeque\tstd::deque\n";
+    std::cout << "sliding window\t" << __sliding_window__<Deque<int>>() 
+        << "\t" << __sliding_window__<StdDeque>() << "\n";
+    std::cout << "both ends\t" << __both_ends__<Deque<int>>() 
+        << "\t" << __both_ends__<StdDeque>() << "\n";
+    std::cout << "random access\t" << __random_access__<Deque<int>>() 
+        << "\t" << __random_access__<StdDeque>() << "\n";
+}
@@ -0,0 +1,111 @@
+#include "Benchmarks.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "BST.h"
+#include "HashMap.h"
+
+static constexpr int KEYS = 1 << 20;
+
+/*
+ * @brief adapts BST to the 
+ *  interface of HashMap. The 
+ *  tree is keyed by the value 
+ *  itself, there's no payload
+ */
+class TreeMap {
+public:
+    void insert(int key, int) { mTree.insert(key); }
+    bool contains(int key) { return mTree.search(key) != nullptr; }
+    void remove(int key) { mTree.remove(key); }
+
+private:
+    BST<int> mTree;
+};
+
+/*
+ * @brief adapts std::unordered_map 
+ *  to the interface of HashMap
+ */
+class StdMap {
+public:
+    void insert(int key, int value) { mMap.emplace(key, value); }
+    bool contains(int key) { return mMap.find(key) != mMap.end(); }
+    void remove(int key) { mMap.erase(key); }
+
+private:
+    std::unordered_map<int, int> mMap;
+};
+
+/*
+ * @brief adapts HashMap, so that 
+ *  remove returns nothing like 
+ *  in the other adapters
+ */
+class SwissMap {
+public:
+    void insert(int key, int value) { mMap.insert(key, value); }
+    bool contains(int key) { return mMap.contains(key); }
+    void remove(int key) { mMap.remove(key); }
+
+private:
+    HashMap<int, int> mMap;
+};
+
+/*
+ * @brief times inserting the keys, 
+ *  looking up present and absent 
+ *  keys and removing them again
+ */
+template<typename Map>
+void __run__(const char* name, const std::vector<int>& keys, const std::vector<int>& misses) {
+    Map map;
+    double insert = time_ms([&] {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            map.insert(keys[i], static_cast<int>(i));
+    });
+    double hit = time_ms([&] {
+        std::size_t found = 0;
+        for (int key : keys)
+            found += map.contains(key);
+        do_not_optimize(found);
+    });
+    double miss = time_ms([&] {
+        std::size_t found = 0;
+        for (int key : misses)
+            found += map.contains(key);
+        do_not_optimize(found);
+    });
+    double remove = time_ms([&] {
+        for (int key : keys)
+            map.remove(key);
+    });
+    std::cout << name << "\t" << insert << "\t" << hit << "\t" << miss << "\t" << remove << "\n";
+}
+
+void hash_benchmark(void) {
+    std::mt19937 rng(42);
+
+    /*
+     * Even keys are inserted and odd 
+     * ones looked up as misses, both 
+     * in random order.
+     */
+    std::vector<int> keys(KEYS), misses(KEYS);
+    for (int i = 0; i < KEYS; ++i) {
+        keys[i] = 2 * i;
+        misses[i] = 2 * i + 1;
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+    std::shuffle(misses.begin(), misses.end(), rng);
+
+    std::cout << KEYS << " random int keys, ms\n";
+    std::cout << "map\tinsert\thit\tmiss\tremove\n";
+    __run__<SwissMap>("HashMap", keys, misses);
+    __run__<StdMap>("std::unordered_map", keys, misses);
+    __run__<TreeMap>("BST", keys, misses);
+}
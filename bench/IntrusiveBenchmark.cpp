@@ -0,0 +1,113 @@
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "IntrusiveList.h"
+#include "List.h"
+
+static constexpr int OBJECTS = 4096;
+static constexpr int ROUNDS = 2000;
+static constexpr int REMOVALS = 20000;
+
+/*
+ * @brief pooled object that is
+ *  put on and off a list
+ */
+struct Object : ListHook<> {
+    int id;
+    char payload[56];
+};
+
+/*
+ * @brief cycles every object through a 
+ *  List, which allocates a node and 
+ *  copies the object each time
+ */
+double __list_cycle__(std::vector<Object>& pool) {
+    return time_ms([&] {
+        List<Object> list;
+        long long sum = 0;
+        for (int round = 0; round < ROUNDS; ++round) {
+            for (Object& object : pool)
+                list.pushBack(object);
+            while (!list.isEmpty())
+                sum += list.popFront().id;
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief cycles every object through an 
+ *  IntrusiveList, which only relinks 
+ *  the object's own hook
+ */
+double __intrusive_cycle__(std::vector<Object>& pool) {
+    return time_ms([&] {
+        IntrusiveList<Object> list;
+        long long sum = 0;
+        for (int round = 0; round < ROUNDS; ++round) {
+            for (Object& object : pool)
+                list.pushBack(object);
+            while (!list.isEmpty())
+                sum += list.popFront().id;
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief removes random objects from a 
+ *  full List by id and puts them back, 
+ *  every removal searches the list
+ */
+double __list_remove__(std::vector<Object>& pool, const std::vector<int>& order) {
+    List<int> list;
+    for (Object& object : pool)
+        list.pushBack(object.id);
+    return time_ms([&] {
+        for (int id : order) {
+            list.remove(id);
+            list.pushBack(id);
+        }
+        do_not_optimize(list.size());
+    });
+}
+
+/*
+ * @brief removes random objects from a 
+ *  full IntrusiveList through their 
+ *  hooks and puts them back
+ */
+double __intrusive_remove__(std::vector<Object>& pool, const std::vector<int>& order) {
+    IntrusiveList<Object> list;
+    for (Object& object : pool)
+        list.pushBack(object);
+    double ms = time_ms([&] {
+        for (int id : order)
+            list.moveToBack(pool[id]);
+        do_not_optimize(list.size());
+    });
+    list.clear();
+    return ms;
+}
+
+void intrusive_benchmark(void) {
+    std::vector<Object> pool(OBJECTS);
+    for (int i = 0; i < OBJECTS; ++i)
+        pool[i].id = i;
+
+    std::mt19937 rng(42);
+    std::vector<int> order(REMOVALS);
+    for (int& id : order)
+        id = static_cast<int>(rng() % OBJECTS);
+
+    std::cout << OBJECTS << " pooled objects of " << sizeof(Object) << " bytes, ms\n";
+    std::cout << "operation\tList\tIntrusiveList\n";
+    std::cout << "push/pop x" << ROUNDS << "\t" << __list_cycle__(pool) << "\t" 
+        << __intrusive_cycle__(pool) << "\n";
+    std::cout << "remove+push x" << REMOVALS << "\t" << __list_remove__(pool, order) << "\t" 
+        << __intrusive_remove__(pool, order) << "\n";
+}
@@ -0,0 +1,49 @@
+#include "Benchmarks.h"
+
+#include <iostream>
+
+#include "List.h"
+#include "UnrolledList.h"
+
+static constexpr int ELEMENTS = 1000000;
+static constexpr int SEARCHES = 20;
+
+/*
+ * @brief builds the container, 
+ *  searches for values near its 
+ *  end and removes a few values
+ *  from the middle
+ */
+template<typename Container>
+void __run__(const char* name) {
+    Container container;
+
+    double build = time_ms([&] {
+        for (int i = 0; i < ELEMENTS; ++i)
+            container.pushBack(i);
+    });
+
+    /*
+     * Missing keys scan the whole 
+     * list, so every search pays 
+     * for a full traversal.
+     */
+    double find = time_ms([&] {
+        for (int i = 0; i < SEARCHES; ++i)
+            do_not_optimize(container.find(ELEMENTS + i));
+    });
+
+    double remove = time_ms([&] {
+        for (int i = 0; i < SEARCHES; ++i)
+            container.remove(ELEMENTS / 2 + i);
+    });
+
+    std::cout << name << ":\tbuild " << build << " ms\tfind " 
+        << find / SEARCHES << " ms/scan\tremove " << remove / SEARCHES << " ms\n";
+}
+
+void list_benchmark(void) {
+    std::cout << ELEMENTS << " ints, " << ChunkNode<int>::CAPACITY << " per chunk\n";
+    __run__<List<int>>("List");
+    __run__<UnrolledList<int>>("UnrolledList");
+}
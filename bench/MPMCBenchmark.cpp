@@ -0,0 +1,100 @@
+#include "Benchmarks.h"
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MPMCQueue.h"
+#include "Queue.h"
+
+static constexpr int MESSAGES = 4000000;
+static constexpr std::size_t CAPACITY = 1 << 12;
+static constexpr int MAX_THREADS = 8;
+
+/*
+ * @brief Queue guarded by a mutex,
+ *  exposing the same try-operations 
+ *  as MPMCQueue
+ */
+class LockedQueue {
+public:
+    LockedQueue(void) : mQueue(CAPACITY, true) {}
+
+    bool tryEnqueue(int value) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mQueue.tryEnqueue(value);
+    }
+
+    bool tryDequeue(int& value) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mQueue.tryDequeue(value);
+    }
+
+private:
+    std::mutex mMutex;
+    Queue<int> mQueue;
+};
+
+/*
+ * @brief splits the messages between 
+ *  the producers and lets the consumers 
+ *  take them until all arrived
+ */
+template<typename Container>
+double __run__(int producers, int consumers) {
+    Container queue;
+    std::atomic<int> received{0};
+    std::atomic<long long> sum{0};
+
+    return time_ms([&] {
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                int count = MESSAGES / producers + (p < MESSAGES % producers);
+                for (int i = 0; i < count; ) {
+                    if (queue.tryEnqueue(i)) { ++i; }
+                    else { std::this_thread::yield(); }
+                }
+            });
+        }
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                long long local = 0;
+                int value;
+                while (received.load(std::memory_order_relaxed) < MESSAGES) {
+                    if (queue.tryDequeue(value)) {
+                        local += value;
+                        received.fetch_add(1, std::memory_order_relaxed);
+                    } else { std::this_thread::yield(); }
+                }
+                sum.fetch_add(local);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+    });
+}
+
+/*
+ * @brief MPMCQueue needs its capacity 
+ *  in the constructor, this gives 
+ *  it the same one as LockedQueue
+ */
+class BenchMPMCQueue : public MPMCQueue<int> {
+public:
+    BenchMPMCQueue(void) : MPMCQueue<int>(CAPACITY) {}
+};
+
+void mpmc_benchmark(void) {
+    std::cout << MESSAGES << " messages, M msg/s\n";
+    std::cout << "producers x consumers\tQueue + mutex\tMPMCQueue\n";
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        double locked = __run__<LockedQueue>(threads, threads);
+        double lockFree = __run__<BenchMPMCQueue>(threads, threads);
+        std::cout << threads << " x " << threads << "\t\t\t" 
+            << MESSAGES / locked / 1000.0 << "\t\t" 
+            << MESSAGES / lockFree / 1000.0 << "\n";
+    }
+}
@@ -0,0 +1,92 @@
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <memory_resource>
+
+#include "BST.h"
+#include "List.h"
+#include "MemoryResource.h"
+
+static constexpr int VALUES = 200000;
+static constexpr int ROUNDS = 10;
+
+template<typename Type>
+using PmrAllocator = std::pmr::polymorphic_allocator<Type>;
+
+/*
+ * @brief shuffled keys, so the 
+ *  tree stays reasonably balanced
+ */
+static int __key__(int value) {
+    return static_cast<int>((static_cast<unsigned int>(value) * 2654435761u) % (4 * VALUES));
+}
+
+/*
+ * @brief fills a tree, then removes 
+ *  and reinserts half of it over and 
+ *  over, the way an index under 
+ *  updates is used
+ */
+template<typename Tree>
+double __tree_churn__(Tree& tree) {
+    return time_ms([&] {
+        for (int i = 0; i < VALUES; ++i)
+            tree.insert(__key__(i));
+        for (int round = 0; round < ROUNDS; ++round) {
+            for (int i = round % 2; i < VALUES; i += 2)
+                tree.remove(__key__(i));
+            for (int i = round % 2; i < VALUES; i += 2)
+                tree.insert(__key__(i));
+        }
+    });
+}
+
+/*
+ * @brief builds and tears down 
+ *  short-lived lists, the way 
+ *  per-request scratch lists 
+ *  are used
+ */
+template<typename MakeList>
+double __list_lifetime__(MakeList makeList) {
+    return time_ms([&] {
+        for (int round = 0; round < ROUNDS; ++round) {
+            auto list = makeList();
+            for (int i = 0; i < VALUES; ++i)
+                list.pushBack(i);
+            do_not_optimize(list.size());
+        }
+    });
+}
+
+void pool_benchmark(void) {
+    std::cout << VALUES << " values, " << ROUNDS << " rounds, ms\n";
+    std::cout << "workload\tstd::allocator\tPoolResource\tArenaResource\n";
+
+    double treeDefault, treePool, treeArena;
+    {
+        BST<int> tree;
+        treeDefault = __tree_churn__(tree);
+    }
+    {
+        PoolResource pool(sizeof(TreeNode<int>), 4096);
+        BST<int, PmrAllocator<int>> tree(&pool);
+        treePool = __tree_churn__(tree);
+    }
+    {
+        ArenaResource arena(1 << 20);
+        BST<int, PmrAllocator<int>> tree(&arena);
+        treeArena = __tree_churn__(tree);
+    }
+    std::cout << "tree churn\t" << treeDefault << "\t" << treePool << "\t" << treeArena << "\n";
+
+    PoolResource pool(sizeof(ListNode<int>), 4096);
+    ArenaResource arena(1 << 20);
+    double listDefault = __list_lifetime__([] { return List<int>(); });
+    double listPool = __list_lifetime__([&] { return List<int, PmrAllocator<int>>(&pool); });
+    double listArena = __list_lifetime__([&] { 
+        arena.release();
+        return List<int, PmrAllocator<int>>(&arena); 
+    });
+    std::cout << "list lifetime\t" << listDefault << "\t" << listPool << "\t" << listArena << "\n";
+}
@@ -0,0 +1,140 @@
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include "Queue.h"
+#include "SPSCQueue.h"
+
+static constexpr int MESSAGES = 10000000;
+static constexpr int ROUND_TRIPS = 100000;
+static constexpr int BATCH = 64;
+static constexpr std::size_t CAPACITY = 1 << 14;
+
+/*
+ * @brief reference point: Queue 
+ *  guarded by a mutex, the way 
+ *  it's shared without SPSCQueue
+ */
+static double __mutex_queue__(void) {
+    Queue<int> queue(CAPACITY);
+    std::mutex mutex;
+
+    return time_ms([&] {
+        std::thread producer([&] {
+            for (int i = 0; i < MESSAGES; ) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (queue.size() < CAPACITY) { queue.enqueue(i++); }
+            }
+        });
+
+        long long sum = 0;
+        for (int received = 0; received < MESSAGES; ) {
+            std::lock_guard<std::mutex> lock(mutex);
+            int value;
+            if (queue.tryDequeue(value)) {
+                sum += value;
+                ++received;
+            }
+        }
+        producer.join();
+        do_not_optimize(sum);
+    });
+}
+
+static double __spsc__(void) {
+    SPSCQueue<int> queue(CAPACITY);
+
+    return time_ms([&] {
+        std::thread producer([&] {
+            for (int i = 0; i < MESSAGES; ) {
+                if (queue.tryEnqueue(i)) { ++i; }
+                else { std::this_thread::yield(); }
+            }
+        });
+
+        long long sum = 0;
+        for (int received = 0; received < MESSAGES; ) {
+            int value;
+            if (queue.tryDequeue(value)) {
+                sum += value;
+                ++received;
+            } else { std::this_thread::yield(); }
+        }
+        producer.join();
+        do_not_optimize(sum);
+    });
+}
+
+static double __spsc_batch__(void) {
+    SPSCQueue<int> queue(CAPACITY);
+
+    return time_ms([&] {
+        std::thread producer([&] {
+            int values[BATCH];
+            for (int i = 0; i < MESSAGES; ) {
+                int count = MESSAGES - i < BATCH ? MESSAGES - i : BATCH;
+                for (int j = 0; j < count; ++j)
+                    values[j] = i + j;
+                std::size_t sent = queue.enqueueBatch(values, count);
+                if (!sent) { std::this_thread::yield(); }
+                i += static_cast<int>(sent);
+            }
+        });
+
+        long long sum = 0;
+        int values[BATCH];
+        for (int received = 0; received < MESSAGES; ) {
+            std::size_t count = queue.dequeueBatch(values, BATCH);
+            if (!count) { std::this_thread::yield(); }
+            for (std::size_t j = 0; j < count; ++j)
+                sum += values[j];
+            received += static_cast<int>(count);
+        }
+        producer.join();
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief ping-pong between two 
+ *  threads over a pair of queues
+ *
+ * @return average round trip 
+ *  in nanoseconds
+ */
+static double __round_trip__(void) {
+    SPSCQueue<int> ping(16), pong(16);
+
+    double elapsed = time_ms([&] {
+        std::thread echo([&] {
+            for (int i = 0; i < ROUND_TRIPS; ++i) {
+                int value;
+                while (!ping.tryDequeue(value)) { std::this_thread::yield(); }
+                while (!pong.tryEnqueue(value)) { std::this_thread::yield(); }
+            }
+        });
+
+        for (int i = 0; i < ROUND_TRIPS; ++i) {
+            int value;
+            while (!ping.tryEnqueue(i)) { std::this_thread::yield(); }
+            while (!pong.tryDequeue(value)) { std::this_thread::yield(); }
+        }
+        echo.join();
+    });
+    return elapsed * 1e6 / ROUND_TRIPS;
+}
+
+void spsc_benchmark(void) {
+    auto report = [](const char* name, double ms) {
+        std::cout << name << ":\t" << ms << " ms\t" 
+            << MESSAGES / ms / 1000.0 << " M msg/s\n";
+    };
+
+    std::cout << MESSAGES << " messages between two threads\n";
+    report("Queue + mutex", __mutex_queue__());
+    report("SPSCQueue", __spsc__());
+    report("SPSCQueue batch", __spsc_batch__());
+    std::cout << "SPSCQueue round trip:\t" << __round_trip__() << " ns\n";
+}
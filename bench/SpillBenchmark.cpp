@@ -0,0 +1,45 @@
+#include "Benchmarks.h"
+
+#include <filesystem>
+#include <iostream>
+
+#include "Queue.h"
+#include "SpillQueue.h"
+
+static constexpr int VALUES = 32 << 20;
+static constexpr std::size_t BUDGET = 16 << 20;
+
+/*
+ * @brief builds up a backlog and 
+ *  replays it, the way a queue 
+ *  behind a downstream outage is 
+ *  used
+ */
+template<typename Container>
+void __backlog__(const char* name, Container& queue) {
+    double fill = time_ms([&] {
+        for (int i = 0; i < VALUES; ++i)
+            queue.enqueue(i);
+    });
+    std::size_t peak = queue.size();
+    double replay = time_ms([&] {
+        long long sum = 0;
+        while (!queue.isEmpty())
+            sum += queue.dequeue();
+        do_not_optimize(sum);
+    });
+    std::cout << name << "\t" << fill << "\t" << replay << "\t" << peak << "\n";
+}
+
+void spill_benchmark(void) {
+    std::string directory = std::filesystem::temp_directory_path().string();
+    std::cout << VALUES << " ints (" << (VALUES * sizeof(int) >> 20) << " MiB) backlog, " 
+        << (BUDGET >> 20) << " MiB budget in " << directory << ", ms\n";
+    std::cout << "queue\tfill\treplay\tbacklog\n";
+
+    Queue<int> queue;
+    __backlog__("Queue", queue);
+
+    SpillQueue<int> spill(directory, BUDGET);
+    __backlog__("SpillQueue", spill);
+}
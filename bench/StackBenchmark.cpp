@@ -0,0 +1,76 @@
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ConcurrentStack.h"
+#include "Stack.h"
+
+static constexpr int OPERATIONS = 2000000;
+static constexpr int MAX_THREADS = 64;
+
+/*
+ * @brief Stack guarded by a mutex, 
+ *  the way it's shared without 
+ *  ConcurrentStack
+ */
+class LockedStack {
+public:
+    void push(int value) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStack.push(value);
+    }
+
+    bool tryPop(int& value) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mStack.isEmpty()) { return false; }
+        value = mStack.pop();
+        return true;
+    }
+
+private:
+    std::mutex mMutex;
+    Stack<int> mStack;
+};
+
+/*
+ * @brief every thread alternates 
+ *  between pushing and popping, 
+ *  the way a shared free-list 
+ *  is used
+ */
+template<typename Container>
+double __run__(int threads) {
+    Container stack;
+    int perThread = OPERATIONS / threads;
+
+    return time_ms([&] {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&] {
+                long long sum = 0;
+                int value;
+                for (int i = 0; i < perThread; ++i) {
+                    stack.push(i);
+                    if (stack.tryPop(value)) { sum += value; }
+                }
+                do_not_optimize(sum);
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+    });
+}
+
+void stack_benchmark(void) {
+    std::cout << OPERATIONS << " push/pop pairs, M ops/s\n";
+    std::cout << "threads\tStack + mutex\tConcurrentStack\n";
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        double locked = __run__<LockedStack>(threads);
+        double lockFree = __run__<ConcurrentStack<int>>(threads);
+        std::cout << threads << "\t" << 2 * OPERATIONS / locked / 1000.0 
+            << "\t\t" << 2 * OPERATIONS / lockFree / 1000.0 << "\n";
+    }
+}
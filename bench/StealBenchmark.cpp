@@ -0,0 +1,84 @@
+#include "Benchmarks.h"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "WorkStealingDeque.h"
+
+static constexpr int TASKS = 4000000;
+static constexpr int MAX_THIEVES = 8;
+
+/*
+ * @brief the owner pushes all of the 
+ *  tasks in bursts and pops some of them 
+ *  back, while the thieves steal. The 
+ *  deque starts tiny, so it has to grow 
+ *  under contention. Every task has to 
+ *  be taken exactly once
+ *
+ * @return false if a task was lost 
+ *  or taken twice
+ */
+static bool __run__(int thieves, double& elapsed, long long& stolen) {
+    WorkStealingDeque<int> deque(2);
+    std::vector<std::atomic<unsigned char>> taken(TASKS);
+    std::atomic<int> done{0};
+    std::atomic<long long> steals{0};
+    std::atomic<bool> duplicate{false};
+
+    auto take = [&](int task) {
+        if (taken[task].fetch_add(1, std::memory_order_relaxed))
+            duplicate.store(true, std::memory_order_relaxed);
+        done.fetch_add(1, std::memory_order_relaxed);
+    };
+
+    elapsed = time_ms([&] {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thieves; ++t) {
+            threads.emplace_back([&] {
+                long long local = 0;
+                int task;
+                while (done.load(std::memory_order_relaxed) < TASKS) {
+                    if (deque.steal(task)) {
+                        take(task);
+                        ++local;
+                    }
+                }
+                steals.fetch_add(local);
+            });
+        }
+
+        int task;
+        for (int i = 0; i < TASKS; ) {
+            for (int burst = 0; burst < 64 && i < TASKS; ++burst)
+                deque.push(i++);
+            for (int burst = 0; burst < 16 && deque.pop(task); ++burst)
+                take(task);
+        }
+        while (deque.pop(task))
+            take(task);
+
+        for (auto& thread : threads)
+            thread.join();
+    });
+
+    stolen = steals.load();
+    if (duplicate.load() || done.load() != TASKS) { return false; }
+    for (auto& flag : taken)
+        if (flag.load(std::memory_order_relaxed) != 1) { return false; }
+    return true;
+}
+
+void steal_benchmark(void) {
+    std::cout << TASKS << " tasks, owner pushes and pops, thieves steal\n";
+    std::cout << "thieves\tms\tstolen\tM steals/s\tcheck\n";
+    for (int thieves = 1; thieves <= MAX_THIEVES; thieves *= 2) {
+        double elapsed;
+        long long stolen;
+        bool ok = __run__(thieves, elapsed, stolen);
+        std::cout << thieves << "\t" << elapsed << "\t" << stolen << "\t" 
+            << stolen / elapsed / 1000.0 << "\t\t" << (ok ? "ok" : "FAILED") << "\n";
+    }
+}
@@ -0,0 +1,90 @@
+#include "Benchmarks.h"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Deque.h"
+#include "MonotonicQueue.h"
+
+static constexpr int SAMPLES = 1 << 20;
+
+/*
+ * @brief keeps the window in a deque 
+ *  and rescans it on every sample
+ */
+static double __rescan__(const std::vector<double>& samples, std::size_t window) {
+    return time_ms([&] {
+        Deque<double> values;
+        double sum = 0;
+        for (double sample : samples) {
+            values.pushBack(sample);
+            if (values.size() > window) { values.popFront(); }
+
+            double min = values[0];
+            double max = values[0];
+            for (std::size_t i = 1; i < values.size(); ++i) {
+                double value = values[i];
+                min = value < min ? value : min;
+                max = value > max ? value : max;
+            }
+            sum += max - min;
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief pushes the samples 
+ *  one by one and queries
+ */
+static double __monotonic__(const std::vector<double>& samples, std::size_t window) {
+    return time_ms([&] {
+        SlidingWindow<double> rolling(window);
+        double sum = 0;
+        for (double sample : samples) {
+            rolling.push(sample);
+            sum += rolling.max() - rolling.min();
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/*
+ * @brief pushes the samples in one 
+ *  batch with per-sample outputs
+ */
+static double __batched__(const std::vector<double>& samples, std::size_t window) {
+    std::vector<double> mins(samples.size());
+    std::vector<double> maxs(samples.size());
+    return time_ms([&] {
+        SlidingWindow<double> rolling(window);
+        rolling.pushRange(samples, mins.data(), maxs.data());
+        do_not_optimize(mins.data());
+        do_not_optimize(maxs.data());
+    });
+}
+
+void window_benchmark(void) {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    /*
+     * A random walk, like a latency 
+     * or price series. Pure noise 
+     * would keep the monotonic queues 
+     * unrealistically short.
+     */
+    std::vector<double> samples(SAMPLES);
+    double level = 0;
+    for (auto& sample : samples)
+        sample = level += noise(rng);
+
+    std::cout << SAMPLES << " samples, rolling min and max, ms\n";
+    std::cout << "window\trescan\tmonotonic\tbatched\n";
+    for (std::size_t window : { 16, 256, 2048 }) {
+        std::cout << window << "\t" << __rescan__(samples, window) 
+            << "\t" << __monotonic__(samples, window) 
+            << "\t" << __batched__(samples, window) << "\n";
+    }
+}
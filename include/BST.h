@@ -1,7 +1,12 @@
 #ifndef BST_H
 #define BST_H
 
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
 
 #include "TreeNode.h"
 #include "Queue.h"
@@ -13,17 +18,147 @@
  * @tparam Type data type to 
  *      be stored within the 
  *      tree
+ * @tparam Alloc allocator of 
+ *      the nodes, rebound to 
+ *      TreeNode
  */
-template<typename Type>
+template<typename Type, typename Alloc = std::allocator<Type>>
 class BST {
 public:
 
+    /*
+     * @brief bidirectional iterator 
+     *  visiting the values in order. 
+     *  The values can't be modified 
+     *  through it, that could break 
+     *  the order of the tree. Removing 
+     *  a value invalidates iterators 
+     *  to it and to the value after it.
+     *  As it's read-only anyway, const 
+     *  trees hand out the same iterator
+     */
+    class Iterator {
+    public:
+
+        using iterator_concept = std::bidirectional_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Type*;
+        using reference = const Type&;
+
+        Iterator(void) : mNode(nullptr), mRoot(nullptr) {}
+
+        /*
+         * @brief creates an iterator 
+         *  pointing at a node
+         *
+         * @param node current node, 
+         *  nullptr for the end
+         * @param root root pointer of 
+         *  the tree, needed to step 
+         *  back from the end
+         */
+        Iterator(TreeNode<Type>* node, TreeNode<Type>* const* root) : 
+            mNode(node), 
+            mRoot(root) 
+        {}
+
+        reference operator*(void) const { return mNode->getData(); }
+        pointer operator->(void) const { return &mNode->getData(); }
+
+        /*
+         * @brief moves to the leftmost node 
+         *  of the right subtree or, without 
+         *  one, to the first ancestor that 
+         *  is reached from its left side
+         */
+        Iterator& operator++(void) {
+            if (mNode->getRight()) {
+                mNode = __leftmost__(mNode->getRight());
+                return *this;
+            }
+            TreeNode<Type>* parent = mNode->getParent();
+            while (parent && parent->getRight() == mNode) {
+                mNode = parent;
+                parent = parent->getParent();
+            }
+            mNode = parent;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        /*
+         * @brief mirror image of the 
+         *  increment, the end steps 
+         *  back to the maximum
+         */
+        Iterator& operator--(void) {
+            if (!mNode) {
+                mNode = __rightmost__(*mRoot);
+                return *this;
+            }
+            if (mNode->getLeft()) {
+                mNode = __rightmost__(mNode->getLeft());
+                return *this;
+            }
+            TreeNode<Type>* parent = mNode->getParent();
+            while (parent && parent->getLeft() == mNode) {
+                mNode = parent;
+                parent = parent->getParent();
+            }
+            mNode = parent;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return mNode == other.mNode; }
+
+    private:
+
+        static TreeNode<Type>* __leftmost__(TreeNode<Type>* node) {
+            while (node->getLeft()) { node = node->getLeft(); }
+            return node;
+        }
+
+        static TreeNode<Type>* __rightmost__(TreeNode<Type>* node) {
+            while (node->getRight()) { node = node->getRight(); }
+            return node;
+        }
+
+        TreeNode<Type>* mNode;
+        TreeNode<Type>* const* mRoot;
+
+    };
+
+    using ConstIterator = Iterator;
+
     /*
      * @brief creates an empty 
      *  binary search tree
      */
     BST(void);
 
+    /*
+     * @brief creates an empty 
+     *  binary search tree that 
+     *  allocates its nodes with 
+     *  the given allocator
+     *
+     * @param alloc allocator
+     */
+    explicit BST(const Alloc& alloc);
+
     /*
      * @brief destroys the binary 
      *  tree by deleting all of 
@@ -38,9 +173,11 @@ public:
      *  exists
      *
      * @param value the value to be 
-     *  inserted into the tree 
+     *  inserted into the tree. An 
+     *  rvalue is moved into the node
      */
     void insert(const Type& value);
+    void insert(Type&& value);
 
     /*
      * @brief removes a value from 
@@ -139,6 +276,23 @@ public:
      */
     void roworder(const std::function<void(const Type& value)>& action);
 
+    /*
+     * @brief returns an iterator 
+     *  to the minimum value
+     *
+     * @return iterator to the 
+     *  first value in order
+     */
+    Iterator begin(void) const;
+
+    /*
+     * @brief returns an iterator 
+     *  past the maximum value
+     *
+     * @return end iterator
+     */
+    Iterator end(void) const;
+
 private:
 
     /*
@@ -180,19 +334,55 @@ private:
     void __recurse_postorder(TreeNode<Type>* node,
             const std::function<void(const Type& value)>& action);
 
+    /*
+     * @brief shared part of both 
+     *  insert overloads. The value 
+     *  is only copied or moved once 
+     *  its place was found
+     *
+     * @param value the value to be 
+     *  inserted into the tree
+     */
+    template<typename Value>
+    void __insert__(Value&& value);
+
+    using NodeAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<TreeNode<Type>>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    /*
+     * @brief allocates and 
+     *  constructs a node
+     *
+     * @param args arguments passed 
+     *  to the constructor of the node
+     */
+    template<typename... Args>
+    TreeNode<Type>* __new_node__(Args&&... args);
+
+    /*
+     * @brief destroys and 
+     *  frees a node
+     */
+    void __delete_node__(TreeNode<Type>* node);
+
     /*
      * @brief root node of the 
      *  binary search tree
      */
     TreeNode<Type>* mRoot;
 
+    [[no_unique_address]] NodeAllocator mAlloc;
+
 };
 
-template<typename Type>
-BST<Type>::BST(void) : mRoot(nullptr) {}
+template<typename Type, typename Alloc>
+BST<Type, Alloc>::BST(void) : mRoot(nullptr) {}
 
-template<typename Type>
-BST<Type>::~BST(void) {
+template<typename Type, typename Alloc>
+BST<Type, Alloc>::BST(const Alloc& alloc) : mRoot(nullptr), mAlloc(alloc) {}
+
+template<typename Type, typename Alloc>
+BST<Type, Alloc>::~BST(void) {
 
     /*
      * Create a queue for the 
@@ -233,12 +423,23 @@ BST<Type>::~BST(void) {
             queue.enqueue(node->getRight());
 
         /* Delete the current node */
-        delete node;
+        this->__delete_node__(node);
     }
 }
 
-template<typename Type>
-void BST<Type>::insert(const Type& value) {
+template<typename Type, typename Alloc>
+void BST<Type, Alloc>::insert(const Type& value) {
+    this->__insert__(value);
+}
+
+template<typename Type, typename Alloc>
+void BST<Type, Alloc>::insert(Type&& value) {
+    this->__insert__(std::move(value));
+}
+
+template<typename Type, typename Alloc>
+template<typename Value>
+void BST<Type, Alloc>::__insert__(Value&& value) {
 
     /*
      * If the root doesn't exist
@@ -246,7 +447,7 @@ void BST<Type>::insert(const Type& value) {
      * assign it to the root
      */
     if (!mRoot) {
-        mRoot = new TreeNode<Type>(value);
+        mRoot = this->__new_node__(std::forward<Value>(value));
         return;
     }
 
@@ -270,7 +471,8 @@ void BST<Type>::insert(const Type& value) {
              * assign it to the left pointer 
              */
             if (!ptr->getLeft()) {
-                ptr->setLeft(new TreeNode(value));
+                ptr->setLeft(this->__new_node__(std::forward<Value>(value)));
+                ptr->getLeft()->setParent(ptr);
                 break;
             }
 
@@ -290,7 +492,8 @@ void BST<Type>::insert(const Type& value) {
              * assign it to the right pointer
              */
             if (!ptr->getRight()) {
-                ptr->setRight(new TreeNode(value));
+                ptr->setRight(this->__new_node__(std::forward<Value>(value)));
+                ptr->getRight()->setParent(ptr);
                 break;
             }
 
@@ -306,8 +509,8 @@ void BST<Type>::insert(const Type& value) {
     }
 }
 
-template<typename Type>
-void BST<Type>::remove(const Type& value) {
+template<typename Type, typename Alloc>
+void BST<Type, Alloc>::remove(const Type& value) {
 
     /*
      * If the tree is empty 
@@ -403,11 +606,13 @@ void BST<Type>::remove(const Type& value) {
         }
 
         /*
-         * Assign the minimum value
+         * Move the minimum value
          * from the right subtree to 
-         * the original 'toDelete' node
+         * the original 'toDelete' node,
+         * as the minimum node is about 
+         * to be deleted anyway
          */
-        toDelete->setData(min->getData());
+        toDelete->setData(std::move(min->getData()));
 
         /*
          * If 'minParent' node is nullptr 
@@ -449,8 +654,16 @@ void BST<Type>::remove(const Type& value) {
          */
         else { minParent->setLeft(min->getRight()); }
 
+        /*
+         * The right child of the minimum 
+         * node moved up to its parent
+         */
+        if (min->getRight()) {
+            min->getRight()->setParent(minParent ? minParent : toDelete);
+        }
+
         /* Delete the minimum node */
-        delete min;
+        this->__delete_node__(min);
 
     /*
      * Else if the 'toDelete' node 
@@ -470,7 +683,8 @@ void BST<Type>::remove(const Type& value) {
         if (!parent) {
             auto tmp = mRoot;
             mRoot = mRoot->getLeft();
-            delete tmp;
+            mRoot->setParent(nullptr);
+            this->__delete_node__(tmp);
 
         /*
          * Else if 'toDelete' is the 
@@ -482,7 +696,8 @@ void BST<Type>::remove(const Type& value) {
          */
         } else if (dir) {
             parent->setRight(toDelete->getLeft());
-            delete toDelete;
+            toDelete->getLeft()->setParent(parent);
+            this->__delete_node__(toDelete);
 
         /*
          * Else if 'toDelete' is the 
@@ -494,7 +709,8 @@ void BST<Type>::remove(const Type& value) {
          */
         } else {
             parent->setLeft(toDelete->getLeft());
-            delete toDelete;
+            toDelete->getLeft()->setParent(parent);
+            this->__delete_node__(toDelete);
         }
 
     /*
@@ -516,7 +732,8 @@ void BST<Type>::remove(const Type& value) {
         if (!parent) {
             auto tmp = mRoot;
             mRoot = mRoot->getRight();
-            delete tmp;
+            mRoot->setParent(nullptr);
+            this->__delete_node__(tmp);
 
         /*
          * Else if 'toDelete' is the 
@@ -528,7 +745,8 @@ void BST<Type>::remove(const Type& value) {
          */
         } else if (dir) {
             parent->setRight(toDelete->getRight());
-            delete toDelete;
+            toDelete->getRight()->setParent(parent);
+            this->__delete_node__(toDelete);
 
         /*
          * Else if 'toDelete' is the 
@@ -540,7 +758,8 @@ void BST<Type>::remove(const Type& value) {
          */
         } else {
             parent->setLeft(toDelete->getRight());
-            delete toDelete;
+            toDelete->getRight()->setParent(parent);
+            this->__delete_node__(toDelete);
         }
 
     /*
@@ -556,14 +775,15 @@ void BST<Type>::remove(const Type& value) {
          * actually the root of the tree
          */
         if (!parent) { 
-            delete mRoot; 
+            this->__delete_node__(mRoot);
+            mRoot = nullptr;
 
         /*
          * The node is the rigth child 
          * of its parent
          */
         } else if (dir) {
-            delete toDelete;
+            this->__delete_node__(toDelete);
             parent->setRight(nullptr);
 
         /*
@@ -571,7 +791,7 @@ void BST<Type>::remove(const Type& value) {
          * of its parent
          */
         } else {
-            delete toDelete;
+            this->__delete_node__(toDelete);
             parent->setLeft(nullptr);
         }
 
@@ -580,8 +800,8 @@ void BST<Type>::remove(const Type& value) {
 
 }
 
-template<typename Type>
-Type* BST<Type>::search(const Type& value) {
+template<typename Type, typename Alloc>
+Type* BST<Type, Alloc>::search(const Type& value) {
 
     /*
      * If the tree is empty then 
@@ -636,8 +856,8 @@ Type* BST<Type>::search(const Type& value) {
     return ptr ? &ptr->getData() : nullptr;
 }
 
-template<typename Type>
-Type* BST<Type>::minimum(void) {
+template<typename Type, typename Alloc>
+Type* BST<Type, Alloc>::minimum(void) {
 
     /*
      * If the tree is empty 
@@ -665,8 +885,8 @@ Type* BST<Type>::minimum(void) {
     return ptr ? &ptr->getData() : nullptr;
 }
 
-template<typename Type>
-Type* BST<Type>::maximum(void) {
+template<typename Type, typename Alloc>
+Type* BST<Type, Alloc>::maximum(void) {
 
     /*
      * If the tree is empty 
@@ -694,8 +914,21 @@ Type* BST<Type>::maximum(void) {
     return ptr ? &ptr->getData() : nullptr;
 }
 
-template <typename Type>
-void BST<Type>::preorder(const std::function<void(const Type& value)>& action) {
+template<typename Type, typename Alloc>
+typename BST<Type, Alloc>::Iterator BST<Type, Alloc>::begin(void) const {
+    TreeNode<Type>* node = mRoot;
+    while (node && node->getLeft())
+        node = node->getLeft();
+    return Iterator(node, &mRoot);
+}
+
+template<typename Type, typename Alloc>
+typename BST<Type, Alloc>::Iterator BST<Type, Alloc>::end(void) const {
+    return Iterator(nullptr, &mRoot);
+}
+
+template <typename Type, typename Alloc>
+void BST<Type, Alloc>::preorder(const std::function<void(const Type& value)>& action) {
 
     /*
      * If the tree is empty 
@@ -710,8 +943,8 @@ void BST<Type>::preorder(const std::function<void(const Type& value)>& action) {
     this->__recurse_preorder__(mRoot, action);
 }
 
-template <typename Type>
-void BST<Type>::inorder(const std::function<void(const Type& value)>& action) {
+template <typename Type, typename Alloc>
+void BST<Type, Alloc>::inorder(const std::function<void(const Type& value)>& action) {
 
     /*
      * If the tree is empty
@@ -726,8 +959,8 @@ void BST<Type>::inorder(const std::function<void(const Type& value)>& action) {
     this->__recurse_inorder__(mRoot, action);
 }
 
-template <typename Type>
-void BST<Type>::postorder(const std::function<void(const Type& value)>& action) {
+template <typename Type, typename Alloc>
+void BST<Type, Alloc>::postorder(const std::function<void(const Type& value)>& action) {
 
     /*
      * If the tree is empty 
@@ -742,8 +975,8 @@ void BST<Type>::postorder(const std::function<void(const Type& value)>& action)
     this->__recurse_postorder(mRoot, action);
 }
 
-template <typename Type>
-void BST<Type>::roworder(const std::function<void(const Type& value)>& action) {
+template <typename Type, typename Alloc>
+void BST<Type, Alloc>::roworder(const std::function<void(const Type& value)>& action) {
 
     /*
      * If the tree is empty
@@ -803,8 +1036,8 @@ void BST<Type>::roworder(const std::function<void(const Type& value)>& action) {
     }
 }
 
-template <typename Type>
-void BST<Type>::__recurse_preorder__(
+template <typename Type, typename Alloc>
+void BST<Type, Alloc>::__recurse_preorder__(
         TreeNode<Type>* node,
         const std::function<void(const Type& value)>& action
 ) {
@@ -845,8 +1078,8 @@ void BST<Type>::__recurse_preorder__(
         this->__recurse_preorder__(node->getRight(), action);   
 }
  
-template <typename Type>
-void BST<Type>::__recurse_inorder__(
+template <typename Type, typename Alloc>
+void BST<Type, Alloc>::__recurse_inorder__(
         TreeNode<Type>* node,
         const std::function<void(const Type& value)>& action
 ) {
@@ -887,8 +1120,8 @@ void BST<Type>::__recurse_inorder__(
         this->__recurse_inorder__(node->getRight(), action);
 }
 
-template <typename Type>
-void BST<Type>::__recurse_postorder(
+template <typename Type, typename Alloc>
+void BST<Type, Alloc>::__recurse_postorder(
         TreeNode<Type>* node,
         const std::function<void(const Type& value)>& action
 ) {
@@ -929,4 +1162,31 @@ void BST<Type>::__recurse_postorder(
     action(node->getData());
 }
 
+template<typename Type, typename Alloc>
+template<typename... Args>
+TreeNode<Type>* BST<Type, Alloc>::__new_node__(Args&&... args) {
+    TreeNode<Type>* node = NodeTraits::allocate(mAlloc, 1);
+    try {
+        NodeTraits::construct(mAlloc, node, std::forward<Args>(args)...);
+    } catch (...) {
+        NodeTraits::deallocate(mAlloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<typename Type, typename Alloc>
+void BST<Type, Alloc>::__delete_node__(TreeNode<Type>* node) {
+    NodeTraits::destroy(mAlloc, node);
+    NodeTraits::deallocate(mAlloc, node, 1);
+}
+
+/*
+ * Read-only code gets the same
+ * ranges support through the
+ * const overloads.
+ */
+static_assert(std::ranges::bidirectional_range<BST<int>>);
+static_assert(std::ranges::bidirectional_range<const BST<int>>);
+
 #endif
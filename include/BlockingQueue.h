@@ -0,0 +1,338 @@
+#ifndef BLOCKING_QUEUE_H
+#define BLOCKING_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "Queue.h"
+
+/*
+* @brief Thread-safe queue whose
+*   consumers wait for values instead
+*   of polling. A waiting consumer
+*   spins for a short while first,
+*   which catches values that arrive
+*   right away without a wakeup, and
+*   then parks on a condition variable
+*   (a futex on Linux). Producers only
+*   signal when someone is parked.
+*
+*   After close no more values can be
+*   added, and the consumers drain the
+*   remaining ones before they get told
+*   that the queue is finished
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+*/
+template<typename Type>
+class BlockingQueue {
+public:
+
+    /*
+    * @brief initializes an empty,
+    *   open queue object
+    */
+    BlockingQueue(void);
+
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    /*
+    * @brief adds a value at the back
+    *   of the queue and wakes up a
+    *   waiting consumer
+    *
+    * @throw std::runtime_error
+    *   if the queue is closed
+    *
+    * @param data value to be
+    *   added to the queue
+    */
+    void enqueue(Type data);
+
+    /*
+    * @brief adds a value at the back
+    *   of the queue unless it's closed
+    *
+    * @param data value to be
+    *   added to the queue
+    *
+    * @return false if the
+    *   queue is closed
+    */
+    bool tryEnqueue(Type data);
+
+    /*
+    * @brief moves the value from the
+    *   front of the queue into out
+    *   without waiting
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the
+    *   queue is empty
+    */
+    bool tryDequeue(Type& out);
+
+    /*
+    * @brief waits for a value and moves
+    *   it from the front of the queue
+    *   into out
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the queue
+    *   was closed and drained
+    */
+    bool dequeueWait(Type& out);
+
+    /*
+    * @brief waits for a value at most
+    *   for the given time and moves it
+    *   from the front of the queue into
+    *   out
+    *
+    * @param out destination
+    *   of the value
+    * @param timeout maximal
+    *   waiting time
+    *
+    * @return false if the time ran
+    *   out or the queue was closed
+    *   and drained
+    */
+    template<typename Rep, typename Period>
+    bool dequeueWait(Type& out, const std::chrono::duration<Rep, Period>& timeout);
+
+    /*
+    * @brief waits until at least one
+    *   value is available and moves up
+    *   to max values into the array
+    *   under a single lock
+    *
+    * @param out destination array
+    * @param max length of the array
+    *
+    * @throw std::invalid_argument
+    *   if max is 0
+    *
+    * @return number of values moved.
+    *   0 if the queue was closed
+    *   and drained
+    */
+    std::size_t dequeueBatch(Type* out, std::size_t max);
+
+    /*
+    * @brief same as dequeueBatch but
+    *   waits at most for the given time
+    *
+    * @param out destination array
+    * @param max length of the array
+    * @param timeout maximal
+    *   waiting time
+    *
+    * @throw std::invalid_argument
+    *   if max is 0
+    *
+    * @return number of values moved.
+    *   0 if the time ran out or the
+    *   queue was closed and drained
+    */
+    template<typename Rep, typename Period>
+    std::size_t dequeueBatch(Type* out, std::size_t max,
+            const std::chrono::duration<Rep, Period>& timeout);
+
+    /*
+    * @brief closes the queue. New values
+    *   are rejected and all of the waiting
+    *   consumers are woken up
+    */
+    void close(void);
+
+    /*
+    * @brief checks if the
+    *   queue was closed
+    *
+    * @return true if closed
+    */
+    bool isClosed(void);
+
+    /*
+    * @brief checks if the queue is
+    *   empty. The answer may be stale
+    *   by the time it's returned
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+private:
+
+    /*
+    * @brief number of polls before
+    *   a consumer parks
+    */
+    static constexpr int SPIN_COUNT = 128;
+
+    /*
+    * @brief spins, then parks until
+    *   there's a value, the queue is
+    *   closed or the deadline passes
+    *
+    * @return lock holding the mutex
+    */
+    std::unique_lock<std::mutex> __wait__(bool timed,
+            std::chrono::steady_clock::time_point deadline);
+
+    /*
+    * @brief moves up to max values
+    *   out of the queue. The mutex
+    *   must be held
+    */
+    std::size_t __take__(Type* out, std::size_t max);
+
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    Queue<Type> mQueue;
+    std::atomic<std::size_t> mSize;
+    std::atomic<bool> mClosed;
+    std::size_t mParked;
+
+};
+
+template<typename Type>
+BlockingQueue<Type>::BlockingQueue(void) : mSize(0), mClosed(false), mParked(0) {}
+
+template<typename Type>
+void BlockingQueue<Type>::enqueue(Type data) {
+    if (!this->tryEnqueue(std::move(data)))
+        throw std::runtime_error("Tried to enqueue into a closed queue");
+}
+
+template<typename Type>
+bool BlockingQueue<Type>::tryEnqueue(Type data) {
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mClosed.load(std::memory_order_relaxed)) { return false; }
+        mQueue.enqueue(std::move(data));
+        mSize.fetch_add(1, std::memory_order_release);
+        wake = mParked != 0;
+    }
+
+    /*
+     * Spinning consumers see the new
+     * size on their own, only parked
+     * ones need the syscall.
+     */
+    if (wake) { mCondition.notify_one(); }
+    return true;
+}
+
+template<typename Type>
+bool BlockingQueue<Type>::tryDequeue(Type& out) {
+    if (!mSize.load(std::memory_order_acquire)) { return false; }
+    std::lock_guard<std::mutex> lock(mMutex);
+    return this->__take__(&out, 1) == 1;
+}
+
+template<typename Type>
+bool BlockingQueue<Type>::dequeueWait(Type& out) {
+    auto lock = this->__wait__(false, {});
+    return this->__take__(&out, 1) == 1;
+}
+
+template<typename Type>
+template<typename Rep, typename Period>
+bool BlockingQueue<Type>::dequeueWait(Type& out,
+        const std::chrono::duration<Rep, Period>& timeout) {
+    auto lock = this->__wait__(true, std::chrono::steady_clock::now() + timeout);
+    return this->__take__(&out, 1) == 1;
+}
+
+template<typename Type>
+std::size_t BlockingQueue<Type>::dequeueBatch(Type* out, std::size_t max) {
+    if (!max)
+        throw std::invalid_argument("Tried to dequeue a batch of 0 values");
+    auto lock = this->__wait__(false, {});
+    return this->__take__(out, max);
+}
+
+template<typename Type>
+template<typename Rep, typename Period>
+std::size_t BlockingQueue<Type>::dequeueBatch(Type* out, std::size_t max,
+        const std::chrono::duration<Rep, Period>& timeout) {
+    if (!max)
+        throw std::invalid_argument("Tried to dequeue a batch of 0 values");
+    auto lock = this->__wait__(true, std::chrono::steady_clock::now() + timeout);
+    return this->__take__(out, max);
+}
+
+template<typename Type>
+void BlockingQueue<Type>::close(void) {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed.store(true);
+    }
+    mCondition.notify_all();
+}
+
+template<typename Type>
+bool BlockingQueue<Type>::isClosed(void) {
+    return mClosed.load();
+}
+
+template<typename Type>
+bool BlockingQueue<Type>::isEmpty(void) {
+    return !mSize.load(std::memory_order_acquire);
+}
+
+template<typename Type>
+std::unique_lock<std::mutex> BlockingQueue<Type>::__wait__(bool timed,
+        std::chrono::steady_clock::time_point deadline) {
+
+    /*
+     * Poll the size without the
+     * mutex first, values that show
+     * up within a few microseconds
+     * are picked up without parking.
+     */
+    for (int i = 0; i < SPIN_COUNT; ++i) {
+        if (mSize.load(std::memory_order_acquire) || mClosed.load(std::memory_order_relaxed))
+            break;
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    auto ready = [this] {
+        return mSize.load(std::memory_order_relaxed) || mClosed.load(std::memory_order_relaxed);
+    };
+    if (ready()) { return lock; }
+
+    ++mParked;
+    if (timed) { mCondition.wait_until(lock, deadline, ready); }
+    else { mCondition.wait(lock, ready); }
+    --mParked;
+    return lock;
+}
+
+template<typename Type>
+std::size_t BlockingQueue<Type>::__take__(Type* out, std::size_t max) {
+    std::size_t count = 0;
+    while (count < max && mQueue.tryDequeue(out[count]))
+        ++count;
+    mSize.fetch_sub(count, std::memory_order_relaxed);
+    return count;
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef CHUNK_NODE_H
+#define CHUNK_NODE_H
+
+#include <cstddef>
+
+/*
+* @brief A building block for unrolled
+*   lists. Instead of a single value it
+*   stores a small array of values, so
+*   that a whole node spans a couple of
+*   cache lines and the pointer is shared
+*   by all of them. The values are stored
+*   at the front of the array
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the node
+*/
+template<typename Type>
+class ChunkNode {
+public:
+
+    /*
+    * @brief size of a whole
+    *   node in bytes
+    */
+    static constexpr std::size_t BYTES = 128;
+
+    /*
+    * @brief number of values
+    *   that fit in a node
+    */
+    static constexpr std::size_t CAPACITY =
+        sizeof(Type) + 2 * sizeof(void*) > BYTES ? 1
+            : (BYTES - 2 * sizeof(void*)) / sizeof(Type);
+
+    /*
+    * @brief initialises an
+    *   empty node
+    */
+    ChunkNode(void);
+
+    /*
+    * @brief returns the array of
+    *   values. Only the first count
+    *   of them are constructed
+    *
+    * @return pointer to the
+    *   first value
+    */
+    Type* getData(void);
+
+    /*
+    * @brief returns the number of
+    *   values stored in the node
+    *
+    * @return value count
+    */
+    std::size_t getCount(void);
+
+    /*
+    * @brief sets the number of
+    *   values stored in the node
+    *
+    * @param count value count
+    */
+    void setCount(std::size_t count);
+
+    /*
+    * @brief sets the next node that
+    *   the current node points to
+    *
+    * @param next pointer to the
+    *   node that the current node
+    *   will point to
+    */
+    void setNext(ChunkNode<Type>* next);
+
+    /*
+    * @brief returns a pointer
+    *   to the next node
+    *
+    * @return pointer to the
+    *   next node
+    */
+    ChunkNode<Type>* getNext(void);
+
+private:
+
+    alignas(64) alignas(Type) unsigned char mData[CAPACITY * sizeof(Type)];
+    ChunkNode<Type>* mNext;
+    std::size_t mCount;
+
+};
+
+template<typename Type>
+ChunkNode<Type>::ChunkNode(void) : mNext(nullptr), mCount(0) {}
+
+template<typename Type>
+Type* ChunkNode<Type>::getData(void) { return reinterpret_cast<Type*>(mData); }
+
+template<typename Type>
+std::size_t ChunkNode<Type>::getCount(void) { return mCount; }
+
+template<typename Type>
+void ChunkNode<Type>::setCount(std::size_t count) { mCount = count; }
+
+template<typename Type>
+void ChunkNode<Type>::setNext(ChunkNode<Type>* next) { mNext = next; }
+
+template<typename Type>
+ChunkNode<Type>* ChunkNode<Type>::getNext(void) { return mNext; }
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef CONCURRENT_STACK_H
+#define CONCURRENT_STACK_H
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+#include "HazardPointers.h"
+
+/*
+* @brief Lock-free stack (Treiber stack)
+*   that can be shared by any number of
+*   threads. Push and pop are a single
+*   CAS on the top pointer.
+*
+*   Popped nodes are reclaimed through
+*   HazardPointers. A thread protects the
+*   top node before it reads its next
+*   pointer, so the node can't be freed
+*   and reused under it, which also rules
+*   out the ABA problem on the CAS
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+*/
+template<typename Type>
+class ConcurrentStack {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty stack object
+    */
+    ConcurrentStack(void);
+
+    /*
+    * @brief deletes the remaining
+    *   nodes. No thread may use
+    *   the stack anymore
+    */
+    ~ConcurrentStack(void);
+
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    /*
+    * @brief pushes a value
+    *   on top of the stack
+    *
+    * @param data value to
+    *   be pushed onto the
+    *   stack
+    */
+    void push(Type data);
+
+    /*
+    * @brief returns the value
+    *   from top of the stack
+    *   and deletes it from the
+    *   stack
+    *
+    * @throw std::runtime_error
+    *   if the stack is empty
+    *
+    * @return value popped
+    *   from the top of the
+    *   stack
+    */
+    Type pop(void);
+
+    /*
+    * @brief moves the value from
+    *   top of the stack into out
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the
+    *   stack is empty
+    */
+    bool tryPop(Type& out);
+
+    /*
+    * @brief checks if the stack is
+    *   empty. The answer may be stale
+    *   by the time it's returned
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+private:
+
+    struct Node {
+        Type data;
+        Node* next;
+    };
+
+    /*
+    * @brief unlinks the top node
+    *
+    * @return the unlinked node or
+    *   nullptr if the stack is empty
+    */
+    Node* __unlink__(void);
+
+    static void __delete__(void* node);
+
+    std::atomic<Node*> mHead;
+
+};
+
+template<typename Type>
+ConcurrentStack<Type>::ConcurrentStack(void) : mHead(nullptr) {}
+
+template<typename Type>
+ConcurrentStack<Type>::~ConcurrentStack(void) {
+    Node* node = mHead.load(std::memory_order_relaxed);
+    while (node) {
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+template<typename Type>
+void ConcurrentStack<Type>::push(Type data) {
+    Node* node = new Node{ std::move(data), mHead.load(std::memory_order_relaxed) };
+
+    /*
+     * On failure the CAS refreshes
+     * node->next with the current top.
+     */
+    while (!mHead.compare_exchange_weak(node->next, node,
+            std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+template<typename Type>
+Type ConcurrentStack<Type>::pop(void) {
+    Node* node = this->__unlink__();
+    if (!node)
+        throw std::runtime_error("Tried to pop from an empty stack");
+    Type data = std::move(node->data);
+    HazardPointers::retire(node, &ConcurrentStack<Type>::__delete__);
+    return data;
+}
+
+template<typename Type>
+bool ConcurrentStack<Type>::tryPop(Type& out) {
+    Node* node = this->__unlink__();
+    if (!node) { return false; }
+    out = std::move(node->data);
+    HazardPointers::retire(node, &ConcurrentStack<Type>::__delete__);
+    return true;
+}
+
+template<typename Type>
+bool ConcurrentStack<Type>::isEmpty(void) {
+    return !mHead.load(std::memory_order_acquire);
+}
+
+template<typename Type>
+typename ConcurrentStack<Type>::Node* ConcurrentStack<Type>::__unlink__(void) {
+    for (;;) {
+        Node* node = HazardPointers::protect(mHead);
+        if (!node) {
+            HazardPointers::clear();
+            return nullptr;
+        }
+
+        /*
+         * Reading next is safe, as the
+         * node is protected. Once the CAS
+         * succeeds this thread owns the
+         * node, other threads may only
+         * still read its next pointer.
+         */
+        Node* next = node->next;
+        if (mHead.compare_exchange_strong(node, next,
+                std::memory_order_acquire, std::memory_order_relaxed)) {
+            HazardPointers::clear();
+            return node;
+        }
+    }
+}
+
+template<typename Type>
+void ConcurrentStack<Type>::__delete__(void* node) {
+    delete static_cast<Node*>(node);
+}
+
+#endif
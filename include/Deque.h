@@ -0,0 +1,524 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*
+* @brief Double-ended queue with O(1)
+*   push and pop at both ends and O(1)
+*   random access.
+*
+*   The values live in fixed size blocks
+*   of about 4 KiB (at least 16 values),
+*   and a map of block pointers keeps the
+*   blocks in order. Growing at either end
+*   only ever adds a block and at most
+*   moves the pointers in the map, so the
+*   values themselves never move and
+*   references to them stay valid until
+*   the value is popped. The block of the
+*   last emptied end is kept as a spare,
+*   so a deque used as a sliding window
+*   doesn't allocate in steady state
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+* @tparam Alloc allocator of the
+*   blocks and of the map
+*/
+template<typename Type, typename Alloc = std::allocator<Type>>
+class Deque {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty deque object. No
+    *   memory is allocated until
+    *   the first push
+    */
+    Deque(void);
+
+    /*
+    * @brief initializes an empty
+    *   deque object that allocates
+    *   its blocks with the given
+    *   allocator
+    *
+    * @param alloc allocator
+    */
+    explicit Deque(const Alloc& alloc);
+
+    /*
+    * @brief destroys the remaining
+    *   values and frees the blocks
+    */
+    ~Deque(void);
+
+    Deque(const Deque&) = delete;
+    Deque& operator=(const Deque&) = delete;
+
+    /*
+    * @brief adds a value at the
+    *   back of the deque
+    *
+    * @param data value to be
+    *   added to the deque
+    */
+    void pushBack(const Type& data);
+    void pushBack(Type&& data);
+
+    /*
+    * @brief adds a value at the
+    *   front of the deque
+    *
+    * @param data value to be
+    *   added to the deque
+    */
+    void pushFront(const Type& data);
+    void pushFront(Type&& data);
+
+    /*
+    * @brief constructs a value in
+    *   place at the back of the deque
+    *
+    * @param args arguments passed
+    *   to the constructor of the value
+    *
+    * @return reference to the
+    *   new value
+    */
+    template<typename... Args>
+    Type& emplaceBack(Args&&... args);
+
+    /*
+    * @brief constructs a value in
+    *   place at the front of the deque
+    *
+    * @param args arguments passed
+    *   to the constructor of the value
+    *
+    * @return reference to the
+    *   new value
+    */
+    template<typename... Args>
+    Type& emplaceFront(Args&&... args);
+
+    /*
+    * @brief returns the value from
+    *   the back of the deque and
+    *   deletes it from the deque
+    *
+    * @throw std::runtime_error
+    *   if the deque is empty
+    *
+    * @return value fetched from
+    *   the back of the deque
+    */
+    Type popBack(void);
+
+    /*
+    * @brief returns the value from
+    *   the front of the deque and
+    *   deletes it from the deque
+    *
+    * @throw std::runtime_error
+    *   if the deque is empty
+    *
+    * @return value fetched from
+    *   the front of the deque
+    */
+    Type popFront(void);
+
+    /*
+    * @brief returns the value from
+    *   the front of the deque without
+    *   deleting it
+    *
+    * @throw std::runtime_error
+    *   if the deque is empty
+    *
+    * @return reference to the
+    *   front value
+    */
+    Type& front(void);
+
+    /*
+    * @brief returns the value from
+    *   the back of the deque without
+    *   deleting it
+    *
+    * @throw std::runtime_error
+    *   if the deque is empty
+    *
+    * @return reference to the
+    *   back value
+    */
+    Type& back(void);
+
+    /*
+    * @brief returns the value at a
+    *   position counted from the front,
+    *   without any bounds checking
+    *
+    * @param idx position of the value
+    *
+    * @return reference to the value
+    */
+    Type& operator[](std::size_t idx);
+
+    /*
+    * @brief returns the value at a
+    *   position counted from the front
+    *
+    * @throw std::runtime_error if
+    *   the position is out of range
+    *
+    * @param idx position of the value
+    *
+    * @return reference to the value
+    */
+    Type& at(std::size_t idx);
+
+    /*
+    * @brief removes all of the values.
+    *   The map is kept for reuse
+    */
+    void clear(void);
+
+    /*
+     * @brief returns true
+     *  if the deque is empty
+     *
+     * @return true if empty,
+     *  false otherwise
+     */
+    bool isEmpty(void);
+
+    /*
+     * @brief returns the number
+     *  of values in the deque
+     *
+     * @return value count
+     */
+    std::size_t size(void);
+
+private:
+
+    /*
+    * @brief number of values in a block,
+    *   the largest power of two that fits
+    *   in 4 KiB, but never less than 16
+    */
+    static constexpr std::size_t __block_size__(void) {
+        std::size_t size = 16;
+        while (size * 2 * sizeof(Type) <= 4096)
+            size *= 2;
+        return size;
+    }
+
+    static constexpr std::size_t BLOCK_SIZE = __block_size__();
+
+    using Traits = std::allocator_traits<Alloc>;
+    using MapAllocator = typename Traits::template rebind_alloc<Type*>;
+    using MapTraits = std::allocator_traits<MapAllocator>;
+
+    /*
+    * @brief returns the address of
+    *   the value at a position
+    *   counted from the map start
+    */
+    Type* __slot__(std::size_t pos);
+
+    /*
+    * @brief allocates a block, or
+    *   takes the spare one
+    */
+    Type* __acquire_block__(void);
+
+    /*
+    * @brief frees the block at the
+    *   given map index, or keeps it
+    *   as the spare one
+    */
+    void __release_block__(std::size_t idx);
+
+    /*
+    * @brief adds a block next to the
+    *   given end. Kept out of the push
+    *   functions, so their common path
+    *   stays small enough to be inlined
+    */
+    void __add_block__(bool atFront);
+
+    /*
+    * @brief makes room in the map for
+    *   one more block at the given end,
+    *   either by recentering the blocks
+    *   in use or by doubling the map
+    */
+    void __grow_map__(bool atFront);
+
+    Type** mMap;
+    std::size_t mMapSize;
+    std::size_t mStart;
+    std::size_t mSize;
+    Type* mSpare;
+    [[no_unique_address]] Alloc mAlloc;
+
+};
+
+template<typename Type, typename Alloc>
+Deque<Type, Alloc>::Deque(void) :
+    mMap(nullptr),
+    mMapSize(0),
+    mStart(0),
+    mSize(0),
+    mSpare(nullptr)
+{}
+
+template<typename Type, typename Alloc>
+Deque<Type, Alloc>::Deque(const Alloc& alloc) :
+    mMap(nullptr),
+    mMapSize(0),
+    mStart(0),
+    mSize(0),
+    mSpare(nullptr),
+    mAlloc(alloc)
+{}
+
+template<typename Type, typename Alloc>
+Deque<Type, Alloc>::~Deque(void) {
+    this->clear();
+    if (mSpare) { Traits::deallocate(mAlloc, mSpare, BLOCK_SIZE); }
+    if (mMap) {
+        MapAllocator mapAlloc(mAlloc);
+        MapTraits::deallocate(mapAlloc, mMap, mMapSize);
+    }
+}
+
+template<typename Type, typename Alloc>
+void Deque<Type, Alloc>::pushBack(const Type& data) {
+    this->emplaceBack(data);
+}
+
+template<typename Type, typename Alloc>
+void Deque<Type, Alloc>::pushBack(Type&& data) {
+    this->emplaceBack(std::move(data));
+}
+
+template<typename Type, typename Alloc>
+void Deque<Type, Alloc>::pushFront(const Type& data) {
+    this->emplaceFront(data);
+}
+
+template<typename Type, typename Alloc>
+void Deque<Type, Alloc>::pushFront(Type&& data) {
+    this->emplaceFront(std::move(data));
+}
+
+template<typename Type, typename Alloc>
+template<typename... Args>
+Type& Deque<Type, Alloc>::emplaceBack(Args&&... args) {
+
+    /*
+     * Every BLOCK_SIZE values
+     * the back steps into a
+     * block that isn't there yet.
+     */
+    bool added = !mSize || (mStart + mSize) % BLOCK_SIZE == 0;
+    if (added) { this->__add_block__(false); }
+
+    /*
+     * If the value can't be built the
+     * new block goes back to the spare,
+     * otherwise every failed push would
+     * strand another block.
+     */
+    std::size_t pos = mStart + mSize;
+    Type* slot;
+    try {
+        slot = new (this->__slot__(pos)) Type(std::forward<Args>(args)...);
+    } catch (...) {
+        if (added) { this->__release_block__(pos / BLOCK_SIZE); }
+        throw;
+    }
+    ++mSize;
+    return *slot;
+}
+
+template<typename Type, typename Alloc>
+template<typename... Args>
+Type& Deque<Type, Alloc>::emplaceFront(Args&&... args) {
+    if (!mSize)
+        return this->emplaceBack(std::forward<Args>(args)...);
+
+    bool added = mStart % BLOCK_SIZE == 0;
+    if (added) { this->__add_block__(true); }
+
+    Type* slot;
+    try {
+        slot = new (this->__slot__(mStart - 1)) Type(std::forward<Args>(args)...);
+    } catch (...) {
+        if (added) { this->__release_block__((mStart - 1) / BLOCK_SIZE); }
+        throw;
+    }
+    --mStart;
+    ++mSize;
+    return *slot;
+}
+
+template<typename Type, typename Alloc>
+Type Deque<Type, Alloc>::popBack(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to pop from an empty deque");
+
+    std::size_t pos = mStart + --mSize;
+    Type* slot = this->__slot__(pos);
+    Type data = std::move(*slot);
+    slot->~Type();
+
+    if (!mSize || pos % BLOCK_SIZE == 0)
+        this->__release_block__(pos / BLOCK_SIZE);
+    return data;
+}
+
+template<typename Type, typename Alloc>
+Type Deque<Type, Alloc>::popFront(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to pop from an empty deque");
+
+    std::size_t pos = mStart++;
+    --mSize;
+    Type* slot = this->__slot__(pos);
+    Type data = std::move(*slot);
+    slot->~Type();
+
+    if (!mSize || mStart % BLOCK_SIZE == 0)
+        this->__release_block__(pos / BLOCK_SIZE);
+    return data;
+}
+
+template<typename Type, typename Alloc>
+Type& Deque<Type, Alloc>::front(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to fetch the front of an empty deque");
+    return *this->__slot__(mStart);
+}
+
+template<typename Type, typename Alloc>
+Type& Deque<Type, Alloc>::back(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to fetch the back of an empty deque");
+    return *this->__slot__(mStart + mSize - 1);
+}
+
+template<typename Type, typename Alloc>
+Type& Deque<Type, Alloc>::operator[](std::size_t idx) {
+    return *this->__slot__(mStart + idx);
+}
+
+template<typename Type, typename Alloc>
+Type& Deque<Type, Alloc>::at(std::size_t idx) {
+    if (idx >= mSize)
+        throw std::runtime_error("Deque index out of range");
+    return *this->__slot__(mStart + idx);
+}
+
+template<typename Type, typename Alloc>
+void Deque<Type, Alloc>::clear(void) {
+    while (mSize)
+        this->popBack();
+}
+
+template<typename Type, typename Alloc>
+bool Deque<Type, Alloc>::isEmpty(void) { return mSize ? false : true; }
+
+template<typename Type, typename Alloc>
+std::size_t Deque<Type, Alloc>::size(void) { return mSize; }
+
+template<typename Type, typename Alloc>
+Type* Deque<Type, Alloc>::__slot__(std::size_t pos) {
+    return mMap[pos / BLOCK_SIZE] + pos % BLOCK_SIZE;
+}
+
+template<typename Type, typename Alloc>
+Type* Deque<Type, Alloc>::__acquire_block__(void) {
+    if (mSpare) {
+        Type* block = mSpare;
+        mSpare = nullptr;
+        return block;
+    }
+    return Traits::allocate(mAlloc, BLOCK_SIZE);
+}
+
+template<typename Type, typename Alloc>
+void Deque<Type, Alloc>::__release_block__(std::size_t idx) {
+    if (mSpare) { Traits::deallocate(mAlloc, mSpare, BLOCK_SIZE); }
+    mSpare = mMap[idx];
+}
+
+template<typename Type, typename Alloc>
+void Deque<Type, Alloc>::__add_block__(bool atFront) {
+    if (atFront) {
+        if (mStart == 0) { this->__grow_map__(true); }
+        mMap[mStart / BLOCK_SIZE - 1] = this->__acquire_block__();
+    } else {
+        if ((mStart + mSize) / BLOCK_SIZE >= mMapSize) { this->__grow_map__(false); }
+        mMap[(mStart + mSize) / BLOCK_SIZE] = this->__acquire_block__();
+    }
+}
+
+template<typename Type, typename Alloc>
+void Deque<Type, Alloc>::__grow_map__(bool atFront) {
+
+    /*
+     * The blocks in use, plus the
+     * one about to be added.
+     */
+    std::size_t first = mStart / BLOCK_SIZE;
+    std::size_t used = mSize ? (mStart + mSize - 1) / BLOCK_SIZE - first + 1 : 0;
+    std::size_t needed = used + 1;
+
+    /*
+     * If the map is mostly free the
+     * blocks are just shifted back to
+     * its middle, otherwise it doubles.
+     * Either way there's room left at
+     * both ends afterwards, so a deque
+     * that keeps sliding one way only
+     * recenters once in a while.
+     */
+    std::size_t mapSize = mMapSize;
+    if (mapSize < 2 * needed + 2)
+        mapSize = mapSize * 2 > 8 ? mapSize * 2 : 8;
+    if (mapSize < 2 * needed + 2)
+        mapSize = 2 * needed + 2;
+
+    std::size_t newFirst = (mapSize - needed) / 2 + (atFront ? 1 : 0);
+
+    /*
+     * Only the slots of the blocks in
+     * use are ever read, so the stale
+     * pointers left behind don't matter.
+     */
+    if (mapSize == mMapSize) {
+        if (used) { std::memmove(mMap + newFirst, mMap + first, used * sizeof(Type*)); }
+    } else {
+        MapAllocator mapAlloc(mAlloc);
+        Type** map = MapTraits::allocate(mapAlloc, mapSize);
+        if (used) { std::memcpy(map + newFirst, mMap + first, used * sizeof(Type*)); }
+        if (mMap) { MapTraits::deallocate(mapAlloc, mMap, mMapSize); }
+        mMap = map;
+        mMapSize = mapSize;
+    }
+
+    mStart = newFirst * BLOCK_SIZE + mStart % BLOCK_SIZE;
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef EXECUTION_POLICY_H
+#define EXECUTION_POLICY_H
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+/*
+* @brief selects how an algorithm
+*   is allowed to execute
+*
+*   seq         - on the calling thread
+*   par         - on the worker threads
+*                 of the global pool
+*   par_unseq   - same as par, the
+*                 algorithms are also
+*                 free to vectorise
+*/
+enum class ExecutionPolicy {
+    seq,
+    par,
+    par_unseq
+};
+
+/*
+* @brief calls body on consecutive
+*   chunks of the [begin, end) range.
+*   With a parallel policy the chunks
+*   are executed by the global pool
+*
+* @param policy execution policy
+* @param begin first index
+* @param end one past the last index
+* @param body function called with
+*   the bounds of every chunk
+* @param grain minimal chunk length
+*/
+void parallel_for(ExecutionPolicy policy, std::size_t begin, std::size_t end,
+        const std::function<void(std::size_t lo, std::size_t hi)>& body,
+        std::size_t grain = 4096);
+
+/*
+* @brief chunk length of the parallel
+*   copies, at least 256 KiB so the
+*   per chunk task overhead stays small
+*/
+template<typename Type>
+constexpr std::size_t parallel_copy_grain(void) {
+    constexpr std::size_t CHUNK_BYTES = std::size_t(256) << 10;
+    return sizeof(Type) < CHUNK_BYTES ? CHUNK_BYTES / sizeof(Type) : 1;
+}
+
+/*
+* @brief copies an array into raw
+*   memory. With a parallel policy the
+*   pool copies the chunks at the same
+*   time. Copying can't throw for
+*   trivially copyable types, so no
+*   chunk ever has to be undone
+*
+* @tparam Type trivially copyable
+*   element type
+*
+* @param policy execution policy
+* @param src source array
+* @param count number of values
+* @param dest destination array,
+*   not overlapping the source
+*/
+template<typename Type>
+void parallel_copy(ExecutionPolicy policy, const Type* src, std::size_t count, Type* dest) {
+    static_assert(std::is_trivially_copyable_v<Type>,
+            "parallel_copy only copies trivially copyable values");
+    parallel_for(policy, 0, count, [=](std::size_t lo, std::size_t hi) {
+        std::memcpy(dest + lo, src + lo, (hi - lo) * sizeof(Type));
+    }, parallel_copy_grain<Type>());
+}
+
+/*
+* @brief same as parallel_copy, but
+*   the last source value ends up
+*   first in the destination
+*
+* @param policy execution policy
+* @param src source array
+* @param count number of values
+* @param dest destination array,
+*   not overlapping the source
+*/
+template<typename Type>
+void parallel_reverse_copy(ExecutionPolicy policy, const Type* src, std::size_t count, Type* dest) {
+    static_assert(std::is_trivially_copyable_v<Type>,
+            "parallel_reverse_copy only copies trivially copyable values");
+    parallel_for(policy, 0, count, [=](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i)
+            dest[i] = src[count - 1 - i];
+    }, parallel_copy_grain<Type>());
+}
+
+#endif
@@ -0,0 +1,259 @@
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "HashTable.h"
+
+/*
+* @brief Unordered map on an open
+*   addressing Swiss table. A lookup
+*   hashes the key once, checks 16 slots
+*   per SSE2 compare and usually touches
+*   a single cache line of slots, instead
+*   of a pointer chase per tree level.
+*   Pointers to values stay valid until
+*   the map rehashes
+*
+* @tparam Key type of the keys
+* @tparam Value type of the values
+* @tparam Hash hash of the keys. With
+*   a transparent hash and equality, e.g.
+*   StringHash and std::equal_to<>, the
+*   map can be searched with any type
+*   they accept
+* @tparam Equal key equality
+* @tparam Alloc allocator of the
+*   key-value pairs
+*/
+template<typename Key, typename Value, typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>, typename Alloc = std::allocator<std::pair<Key, Value>>>
+class HashMap {
+public:
+
+    /*
+    * @brief initialises an
+    *   empty map object. No
+    *   memory is allocated until
+    *   the first insert
+    */
+    HashMap(void);
+
+    /*
+    * @brief initialises an empty
+    *   map object that allocates
+    *   with the given allocator
+    * 
+    * @param alloc allocator
+    */
+    explicit HashMap(const Alloc& alloc);
+
+    HashMap(HashMap&&) = default;
+    HashMap& operator=(HashMap&&) = default;
+
+    HashMap(const HashMap&) = delete;
+    HashMap& operator=(const HashMap&) = delete;
+
+    /*
+    * @brief inserts a key with a
+    *   value if the key isn't in the
+    *   map yet
+    * 
+    * @param key key to be inserted
+    * @param value value of the key
+    * 
+    * @return false if the key was
+    *   already there. Its value is
+    *   left untouched
+    */
+    template<typename K, typename V>
+    bool insert(K&& key, V&& value);
+
+    /*
+    * @brief inserts a key with a value,
+    *   or replaces the value if the key
+    *   is already there
+    * 
+    * @param key key to be inserted
+    * @param value value of the key
+    * 
+    * @return true if the key
+    *   was inserted
+    */
+    template<typename K, typename V>
+    bool insertOrAssign(K&& key, V&& value);
+
+    /*
+    * @brief returns the value of a key,
+    *   inserting a default constructed
+    *   one if the key isn't there
+    * 
+    * @param key key to look up
+    * 
+    * @return reference to the value
+    */
+    template<typename K>
+    Value& operator[](K&& key);
+
+    /*
+    * @brief finds the value of a key
+    * 
+    * @param key key to search for
+    * 
+    * @return pointer to the value or
+    *   nullptr if the key isn't there
+    */
+    template<typename K>
+    Value* find(const K& key);
+
+    /*
+    * @brief checks if a key
+    *   is in the map
+    * 
+    * @param key key to search for
+    * 
+    * @return true if found
+    */
+    template<typename K>
+    bool contains(const K& key);
+
+    /*
+    * @brief removes a key. The slot is
+    *   emptied right away if no probe
+    *   could have passed it, otherwise
+    *   it's left as a tombstone
+    * 
+    * @param key key to be removed
+    * 
+    * @return false if the key
+    *   wasn't in the map
+    */
+    template<typename K>
+    bool remove(const K& key);
+
+    /*
+    * @brief makes room for the given
+    *   number of keys, so that inserting
+    *   them doesn't rehash
+    * 
+    * @param count number of keys
+    */
+    void reserve(std::size_t count);
+
+    /*
+    * @brief removes all of the keys.
+    *   The memory is kept
+    */
+    void clear(void);
+
+    /*
+    * @brief checks if the
+    *   map is empty
+    * 
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number
+    *   of keys in the map
+    * 
+    * @return key count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief returns the number
+    *   of slots in the table
+    * 
+    * @return slot count
+    */
+    std::size_t capacity(void);
+
+private:
+
+    using Entry = std::pair<Key, Value>;
+
+    /*
+    * @brief returns the key
+    *   of an entry
+    */
+    struct KeyOf {
+        const Key& operator()(const Entry& entry) const { return entry.first; }
+    };
+
+    HashTable<Key, Entry, KeyOf, Hash, Equal, Alloc> mTable;
+
+};
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+HashMap<Key, Value, Hash, Equal, Alloc>::HashMap(void) {}
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+HashMap<Key, Value, Hash, Equal, Alloc>::HashMap(const Alloc& alloc) : mTable(alloc) {}
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+template<typename K, typename V>
+bool HashMap<Key, Value, Hash, Equal, Alloc>::insert(K&& key, V&& value) {
+    return mTable.emplace(key, std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<V>(value))).second;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+template<typename K, typename V>
+bool HashMap<Key, Value, Hash, Equal, Alloc>::insertOrAssign(K&& key, V&& value) {
+    if (Entry* entry = mTable.find(key)) {
+        entry->second = std::forward<V>(value);
+        return false;
+    }
+    return this->insert(std::forward<K>(key), std::forward<V>(value));
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+Value& HashMap<Key, Value, Hash, Equal, Alloc>::operator[](K&& key) {
+    return mTable.emplace(key, std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple()).first->second;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+Value* HashMap<Key, Value, Hash, Equal, Alloc>::find(const K& key) {
+    Entry* entry = mTable.find(key);
+    return entry ? &entry->second : nullptr;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+bool HashMap<Key, Value, Hash, Equal, Alloc>::contains(const K& key) {
+    return mTable.find(key) != nullptr;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+bool HashMap<Key, Value, Hash, Equal, Alloc>::remove(const K& key) {
+    return mTable.erase(key);
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+void HashMap<Key, Value, Hash, Equal, Alloc>::reserve(std::size_t count) { mTable.reserve(count); }
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+void HashMap<Key, Value, Hash, Equal, Alloc>::clear(void) { mTable.clear(); }
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+bool HashMap<Key, Value, Hash, Equal, Alloc>::isEmpty(void) { return !mTable.size(); }
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+std::size_t HashMap<Key, Value, Hash, Equal, Alloc>::size(void) { return mTable.size(); }
+
+template<typename Key, typename Value, typename Hash, typename Equal, typename Alloc>
+std::size_t HashMap<Key, Value, Hash, Equal, Alloc>::capacity(void) { return mTable.capacity(); }
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef HASH_SET_H
+#define HASH_SET_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "HashTable.h"
+
+/*
+* @brief Unordered set on an open
+*   addressing Swiss table, see
+*   HashMap
+*
+* @tparam Key type of the keys
+* @tparam Hash hash of the keys. With
+*   a transparent hash and equality the
+*   set can be searched with any type
+*   they accept
+* @tparam Equal key equality
+* @tparam Alloc allocator
+*   of the keys
+*/
+template<typename Key, typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>, typename Alloc = std::allocator<Key>>
+class HashSet {
+public:
+
+    /*
+    * @brief initialises an
+    *   empty set object. No
+    *   memory is allocated until
+    *   the first insert
+    */
+    HashSet(void);
+
+    /*
+    * @brief initialises an empty
+    *   set object that allocates
+    *   with the given allocator
+    * 
+    * @param alloc allocator
+    */
+    explicit HashSet(const Alloc& alloc);
+
+    HashSet(HashSet&&) = default;
+    HashSet& operator=(HashSet&&) = default;
+
+    HashSet(const HashSet&) = delete;
+    HashSet& operator=(const HashSet&) = delete;
+
+    /*
+    * @brief inserts a key if it
+    *   isn't in the set yet
+    * 
+    * @param key key to be inserted
+    * 
+    * @return false if the key
+    *   was already there
+    */
+    template<typename K>
+    bool insert(K&& key);
+
+    /*
+    * @brief finds a key
+    * 
+    * @param key key to search for
+    * 
+    * @return pointer to the stored
+    *   key or nullptr if it isn't there
+    */
+    template<typename K>
+    const Key* find(const K& key);
+
+    /*
+    * @brief checks if a key
+    *   is in the set
+    * 
+    * @param key key to search for
+    * 
+    * @return true if found
+    */
+    template<typename K>
+    bool contains(const K& key);
+
+    /*
+    * @brief removes a key. The slot is
+    *   emptied right away if no probe
+    *   could have passed it, otherwise
+    *   it's left as a tombstone
+    * 
+    * @param key key to be removed
+    * 
+    * @return false if the key
+    *   wasn't in the set
+    */
+    template<typename K>
+    bool remove(const K& key);
+
+    /*
+    * @brief makes room for the given
+    *   number of keys, so that inserting
+    *   them doesn't rehash
+    * 
+    * @param count number of keys
+    */
+    void reserve(std::size_t count);
+
+    /*
+    * @brief removes all of the keys.
+    *   The memory is kept
+    */
+    void clear(void);
+
+    /*
+    * @brief checks if the
+    *   set is empty
+    * 
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number
+    *   of keys in the set
+    * 
+    * @return key count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief returns the number
+    *   of slots in the table
+    * 
+    * @return slot count
+    */
+    std::size_t capacity(void);
+
+private:
+
+    /*
+    * @brief the slots hold
+    *   just the keys
+    */
+    struct KeyOf {
+        const Key& operator()(const Key& key) const { return key; }
+    };
+
+    HashTable<Key, Key, KeyOf, Hash, Equal, Alloc> mTable;
+
+};
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+HashSet<Key, Hash, Equal, Alloc>::HashSet(void) {}
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+HashSet<Key, Hash, Equal, Alloc>::HashSet(const Alloc& alloc) : mTable(alloc) {}
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+bool HashSet<Key, Hash, Equal, Alloc>::insert(K&& key) {
+    return mTable.emplace(key, std::forward<K>(key)).second;
+}
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+const Key* HashSet<Key, Hash, Equal, Alloc>::find(const K& key) {
+    return mTable.find(key);
+}
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+bool HashSet<Key, Hash, Equal, Alloc>::contains(const K& key) {
+    return mTable.find(key) != nullptr;
+}
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+bool HashSet<Key, Hash, Equal, Alloc>::remove(const K& key) {
+    return mTable.erase(key);
+}
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+void HashSet<Key, Hash, Equal, Alloc>::reserve(std::size_t count) { mTable.reserve(count); }
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+void HashSet<Key, Hash, Equal, Alloc>::clear(void) { mTable.clear(); }
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+bool HashSet<Key, Hash, Equal, Alloc>::isEmpty(void) { return !mTable.size(); }
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+std::size_t HashSet<Key, Hash, Equal, Alloc>::size(void) { return mTable.size(); }
+
+template<typename Key, typename Hash, typename Equal, typename Alloc>
+std::size_t HashSet<Key, Hash, Equal, Alloc>::capacity(void) { return mTable.capacity(); }
+
+#endif
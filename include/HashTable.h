@@ -0,0 +1,578 @@
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+* Open addressing hash table in the style
+* of the Swiss tables, shared by HashMap
+* and HashSet. Next to the slots the table
+* keeps one control byte per slot:
+*
+*   0..127  - full, low 7 bits of the hash
+*   EMPTY   - never used since the last
+*             rehash, ends a probe
+*   DELETED - tombstone, a probe has
+*             to go on past it
+*
+* A probe looks at 16 control bytes at
+* once, with one SSE2 compare per group,
+* and only compares the keys whose 7 hash
+* bits matched. The first 16 control bytes
+* are mirrored behind the last one, so a
+* group can start at any slot.
+*/
+
+/*
+* @brief transparent hash for strings.
+*   A HashMap or HashSet of std::string
+*   keys with StringHash and
+*   std::equal_to<> can be searched with
+*   a string_view or a string literal
+*   without building a std::string
+*/
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view text) const {
+        return std::hash<std::string_view>()(text);
+    }
+};
+
+/*
+* @brief one probe window
+*   of 16 control bytes
+*/
+class HashGroup {
+public:
+
+    static constexpr std::size_t WIDTH = 16;
+    static constexpr std::int8_t EMPTY = -128;
+    static constexpr std::int8_t DELETED = -2;
+
+    explicit HashGroup(const std::int8_t* ctrl) {
+#if defined(__SSE2__)
+        mCtrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+        for (std::size_t i = 0; i < WIDTH; ++i)
+            mCtrl[i] = ctrl[i];
+#endif
+    }
+
+    /*
+    * @brief returns a bit for every
+    *   byte equal to the given one
+    */
+    std::uint32_t match(std::int8_t hash) const {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_set1_epi8(hash), mCtrl)));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < WIDTH; ++i)
+            mask |= static_cast<std::uint32_t>(mCtrl[i] == hash) << i;
+        return mask;
+#endif
+    }
+
+    /*
+    * @brief returns a bit for
+    *   every empty byte
+    */
+    std::uint32_t matchEmpty(void) const {
+        return this->match(EMPTY);
+    }
+
+    /*
+    * @brief returns a bit for every empty
+    *   or deleted byte. Those are the only
+    *   negative ones, so it's just the
+    *   sign bits
+    */
+    std::uint32_t matchFree(void) const {
+#if defined(__SSE2__)
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(mCtrl));
+#else
+        std::uint32_t mask = 0;
+        for (std::size_t i = 0; i < WIDTH; ++i)
+            mask |= static_cast<std::uint32_t>(mCtrl[i] < 0) << i;
+        return mask;
+#endif
+    }
+
+private:
+
+#if defined(__SSE2__)
+    __m128i mCtrl;
+#else
+    std::int8_t mCtrl[WIDTH];
+#endif
+
+};
+
+/*
+* @brief the table behind HashMap
+*   and HashSet
+*
+* @tparam Key type of the keys
+* @tparam Slot type stored in a slot
+* @tparam KeyOf functor returning
+*   the key of a slot
+* @tparam Hash hash of the keys
+* @tparam Equal key equality
+* @tparam Alloc allocator, rebound
+*   to the slots and control bytes
+*/
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+class HashTable {
+public:
+
+    HashTable(void);
+    explicit HashTable(const Alloc& alloc);
+    ~HashTable(void);
+
+    HashTable(HashTable&& other);
+    HashTable& operator=(HashTable&& other);
+
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
+
+    /*
+    * @brief finds the slot of a key
+    *
+    * @return the slot or nullptr
+    */
+    template<typename K>
+    Slot* find(const K& key);
+
+    /*
+    * @brief builds a slot from the given
+    *   arguments if the key isn't in the
+    *   table yet
+    *
+    * @return the slot of the key and
+    *   true if it was just built
+    */
+    template<typename K, typename... Args>
+    std::pair<Slot*, bool> emplace(const K& key, Args&&... args);
+
+    /*
+    * @brief removes a key
+    *
+    * @return false if the key
+    *   wasn't in the table
+    */
+    template<typename K>
+    bool erase(const K& key);
+
+    /*
+    * @brief makes room for the given
+    *   number of keys without rehashing
+    */
+    void reserve(std::size_t count);
+
+    void clear(void);
+    std::size_t size(void);
+    std::size_t capacity(void);
+
+private:
+
+    /*
+    * @brief key types other than Key
+    *   are looked up directly only if
+    *   both functors are transparent,
+    *   otherwise they're converted
+    */
+    template<typename K>
+    static constexpr bool DIRECT_LOOKUP = std::is_same_v<K, Key>
+        || (requires { typename Hash::is_transparent; }
+            && requires { typename Equal::is_transparent; });
+
+    using SlotAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Slot>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+    using CtrlAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<std::int8_t>;
+    using CtrlTraits = std::allocator_traits<CtrlAllocator>;
+
+    static constexpr std::size_t MIN_CAPACITY = HashGroup::WIDTH;
+
+    /*
+    * @brief spreads the bits of the
+    *   hash, so that hashes like the
+    *   identity of std::hash<int> still
+    *   fill the 7 bit tags
+    */
+    template<typename K>
+    std::size_t __hash__(const K& key);
+
+    template<typename K>
+    Slot* __find__(const K& key, std::size_t hash);
+
+    /*
+    * @brief returns the index of the
+    *   first empty or deleted slot on
+    *   the probe sequence of a hash
+    */
+    std::size_t __find_free__(std::size_t hash);
+
+    /*
+    * @brief sets a control byte
+    *   and its mirror
+    */
+    void __set_ctrl__(std::size_t idx, std::int8_t ctrl);
+
+    /*
+    * @brief makes room for one more key
+    *   once the growth is used up. If
+    *   tombstones took up most of it,
+    *   dropping them is enough, otherwise
+    *   the capacity doubles
+    */
+    void __grow__(void);
+
+    /*
+    * @brief moves the slots into
+    *   a table of the given capacity
+    */
+    void __rehash__(std::size_t capacity);
+
+    /*
+    * @brief destroys the slots
+    *   and frees the arrays
+    */
+    void __release__(void);
+
+    static std::size_t __growth__(std::size_t capacity) {
+        return capacity - capacity / 8;
+    }
+
+    std::int8_t* mCtrl;
+    Slot* mSlots;
+    std::size_t mCapacity;
+    std::size_t mSize;
+    std::size_t mGrowthLeft;
+    [[no_unique_address]] Hash mHashFn;
+    [[no_unique_address]] Equal mEqual;
+    [[no_unique_address]] SlotAllocator mAlloc;
+
+};
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::HashTable(void) :
+    mCtrl(nullptr),
+    mSlots(nullptr),
+    mCapacity(0),
+    mSize(0),
+    mGrowthLeft(0)
+{}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::HashTable(const Alloc& alloc) :
+    mCtrl(nullptr),
+    mSlots(nullptr),
+    mCapacity(0),
+    mSize(0),
+    mGrowthLeft(0),
+    mAlloc(alloc)
+{}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::~HashTable(void) {
+    this->__release__();
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::HashTable(HashTable&& other) :
+    mCtrl(other.mCtrl),
+    mSlots(other.mSlots),
+    mCapacity(other.mCapacity),
+    mSize(other.mSize),
+    mGrowthLeft(other.mGrowthLeft),
+    mHashFn(std::move(other.mHashFn)),
+    mEqual(std::move(other.mEqual)),
+    mAlloc(std::move(other.mAlloc))
+{
+    other.mCtrl = nullptr;
+    other.mSlots = nullptr;
+    other.mCapacity = other.mSize = other.mGrowthLeft = 0;
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>&
+HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::operator=(HashTable&& other) {
+    if (&other == this) { return *this; }
+    this->__release__();
+
+    /*
+     * The arrays can only change hands
+     * if this table frees them the same
+     * way. Otherwise the slots are
+     * moved over one by one.
+     */
+    if constexpr (SlotTraits::propagate_on_container_move_assignment::value)
+        mAlloc = std::move(other.mAlloc);
+    mHashFn = std::move(other.mHashFn);
+    mEqual = std::move(other.mEqual);
+
+    if (mAlloc == other.mAlloc) {
+        mCtrl = other.mCtrl;
+        mSlots = other.mSlots;
+        mCapacity = other.mCapacity;
+        mSize = other.mSize;
+        mGrowthLeft = other.mGrowthLeft;
+        other.mCtrl = nullptr;
+        other.mSlots = nullptr;
+        other.mCapacity = other.mSize = other.mGrowthLeft = 0;
+        return *this;
+    }
+
+    this->reserve(other.mSize);
+    for (std::size_t i = 0; i < other.mCapacity; ++i) {
+        if (other.mCtrl[i] < 0) { continue; }
+        Slot& slot = other.mSlots[i];
+        this->emplace(KeyOf()(slot), std::move(slot));
+    }
+    other.clear();
+    return *this;
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+Slot* HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::find(const K& key) {
+    if (!mSize) { return nullptr; }
+    if constexpr (DIRECT_LOOKUP<K>) {
+        return this->__find__(key, this->__hash__(key));
+    } else {
+        Key converted(key);
+        return this->__find__(converted, this->__hash__(converted));
+    }
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+template<typename K, typename... Args>
+std::pair<Slot*, bool> HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::emplace(const K& key, Args&&... args) {
+    if constexpr (!DIRECT_LOOKUP<K>) {
+        Key converted(key);
+        return this->emplace(converted, std::forward<Args>(args)...);
+    } else {
+        std::size_t hash = this->__hash__(key);
+        if (mSize) {
+            if (Slot* slot = this->__find__(key, hash)) { return { slot, false }; }
+        }
+
+        /*
+         * Reusing a tombstone doesn't use
+         * up any growth, only taking an
+         * empty slot does.
+         */
+        std::size_t idx = mCapacity ? this->__find_free__(hash) : 0;
+        if (!mCapacity || (!mGrowthLeft && mCtrl[idx] == HashGroup::EMPTY)) {
+            this->__grow__();
+            idx = this->__find_free__(hash);
+        }
+
+        /*
+         * The slot is only marked full once
+         * it's built, so a throwing constructor
+         * leaves the table as it was.
+         */
+        Slot* slot = mSlots + idx;
+        SlotTraits::construct(mAlloc, slot, std::forward<Args>(args)...);
+        if (mCtrl[idx] == HashGroup::EMPTY) { --mGrowthLeft; }
+        this->__set_ctrl__(idx, static_cast<std::int8_t>(hash & 0x7F));
+        ++mSize;
+        return { slot, true };
+    }
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+bool HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::erase(const K& key) {
+    Slot* slot = this->find(key);
+    if (!slot) { return false; }
+
+    std::size_t idx = static_cast<std::size_t>(slot - mSlots);
+    SlotTraits::destroy(mAlloc, slot);
+    --mSize;
+
+    /*
+     * A probe only stops at an empty byte.
+     * If every window of 16 bytes that
+     * covers this slot already had an empty
+     * byte, no probe ever went past this
+     * slot while it was full, so it can be
+     * emptied instead of left as a tombstone.
+     */
+    std::size_t mask = mCapacity - 1;
+    std::uint32_t emptyBefore = HashGroup(mCtrl + ((idx - HashGroup::WIDTH) & mask)).matchEmpty();
+    std::uint32_t emptyAfter = HashGroup(mCtrl + idx).matchEmpty();
+    bool neverFull = emptyBefore && emptyAfter
+        && static_cast<std::size_t>(__builtin_ctz(emptyAfter) + __builtin_clz(emptyBefore << 16))
+            < HashGroup::WIDTH;
+
+    if (neverFull) {
+        this->__set_ctrl__(idx, HashGroup::EMPTY);
+        ++mGrowthLeft;
+    } else {
+        this->__set_ctrl__(idx, HashGroup::DELETED);
+    }
+    return true;
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+void HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::reserve(std::size_t count) {
+    std::size_t capacity = MIN_CAPACITY;
+    while (__growth__(capacity) < count)
+        capacity *= 2;
+
+    /*
+     * The capacity may be large enough
+     * while tombstones take up the room,
+     * then dropping them is enough.
+     */
+    if (capacity > mCapacity) { this->__rehash__(capacity); }
+    else if (count > mSize && count - mSize > mGrowthLeft) { this->__rehash__(mCapacity); }
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+void HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::clear(void) {
+    if (!mCapacity) { return; }
+    for (std::size_t i = 0; i < mCapacity; ++i) {
+        if (mCtrl[i] >= 0) { SlotTraits::destroy(mAlloc, mSlots + i); }
+    }
+    std::fill(mCtrl, mCtrl + mCapacity + HashGroup::WIDTH, HashGroup::EMPTY);
+    mSize = 0;
+    mGrowthLeft = __growth__(mCapacity);
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+std::size_t HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::size(void) { return mSize; }
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+std::size_t HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::capacity(void) { return mCapacity; }
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+std::size_t HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::__hash__(const K& key) {
+    std::uint64_t hash = static_cast<std::uint64_t>(mHashFn(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(hash ^ (hash >> 32));
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+template<typename K>
+Slot* HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::__find__(const K& key, std::size_t hash) {
+    std::size_t mask = mCapacity - 1;
+    std::size_t pos = (hash >> 7) & mask;
+    std::int8_t tag = static_cast<std::int8_t>(hash & 0x7F);
+
+    /*
+     * Groups are visited at triangular
+     * offsets, which reach every group
+     * of a power of two table.
+     */
+    for (std::size_t step = HashGroup::WIDTH; ; pos = (pos + step) & mask, step += HashGroup::WIDTH) {
+        HashGroup group(mCtrl + pos);
+        for (std::uint32_t hits = group.match(tag); hits; hits &= hits - 1) {
+            std::size_t idx = (pos + static_cast<std::size_t>(__builtin_ctz(hits))) & mask;
+            if (mEqual(KeyOf()(mSlots[idx]), key)) { return mSlots + idx; }
+        }
+        if (group.matchEmpty()) { return nullptr; }
+    }
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+std::size_t HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::__find_free__(std::size_t hash) {
+    std::size_t mask = mCapacity - 1;
+    std::size_t pos = (hash >> 7) & mask;
+    for (std::size_t step = HashGroup::WIDTH; ; pos = (pos + step) & mask, step += HashGroup::WIDTH) {
+        std::uint32_t free = HashGroup(mCtrl + pos).matchFree();
+        if (free) { return (pos + static_cast<std::size_t>(__builtin_ctz(free))) & mask; }
+    }
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+void HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::__set_ctrl__(std::size_t idx, std::int8_t ctrl) {
+    mCtrl[idx] = ctrl;
+    if (idx < HashGroup::WIDTH) { mCtrl[mCapacity + idx] = ctrl; }
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+void HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::__grow__(void) {
+
+    /*
+     * Rehashing in place only pays off
+     * if it frees a good part of the
+     * table, otherwise a run of inserts
+     * and removes near the limit would
+     * rehash over and over.
+     */
+    if (!mCapacity) { this->__rehash__(MIN_CAPACITY); }
+    else if (mSize * 32 <= mCapacity * 25) { this->__rehash__(mCapacity); }
+    else { this->__rehash__(mCapacity * 2); }
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+void HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::__rehash__(std::size_t capacity) {
+    CtrlAllocator ctrlAlloc(mAlloc);
+    std::int8_t* oldCtrl = mCtrl;
+    Slot* oldSlots = mSlots;
+    std::size_t oldCapacity = mCapacity;
+
+    mSlots = SlotTraits::allocate(mAlloc, capacity);
+    try {
+        mCtrl = CtrlTraits::allocate(ctrlAlloc, capacity + HashGroup::WIDTH);
+    } catch (...) {
+        SlotTraits::deallocate(mAlloc, mSlots, capacity);
+        mSlots = oldSlots;
+        throw;
+    }
+    std::fill(mCtrl, mCtrl + capacity + HashGroup::WIDTH, HashGroup::EMPTY);
+    mCapacity = capacity;
+    mGrowthLeft = __growth__(capacity) - mSize;
+
+    /*
+     * The new table has no tombstones and
+     * every key is known to be unique, so
+     * each one goes to the first free slot
+     * of its probe sequence.
+     */
+    for (std::size_t i = 0; i < oldCapacity; ++i) {
+        if (oldCtrl[i] < 0) { continue; }
+        Slot* slot = oldSlots + i;
+        std::size_t hash = this->__hash__(KeyOf()(*slot));
+        std::size_t idx = this->__find_free__(hash);
+        SlotTraits::construct(mAlloc, mSlots + idx, std::move(*slot));
+        SlotTraits::destroy(mAlloc, slot);
+        this->__set_ctrl__(idx, static_cast<std::int8_t>(hash & 0x7F));
+    }
+
+    if (oldCapacity) {
+        SlotTraits::deallocate(mAlloc, oldSlots, oldCapacity);
+        CtrlTraits::deallocate(ctrlAlloc, oldCtrl, oldCapacity + HashGroup::WIDTH);
+    }
+}
+
+template<typename Key, typename Slot, typename KeyOf, typename Hash, typename Equal, typename Alloc>
+void HashTable<Key, Slot, KeyOf, Hash, Equal, Alloc>::__release__(void) {
+    if (!mCapacity) { return; }
+    this->clear();
+    CtrlAllocator ctrlAlloc(mAlloc);
+    SlotTraits::deallocate(mAlloc, mSlots, mCapacity);
+    CtrlTraits::deallocate(ctrlAlloc, mCtrl, mCapacity + HashGroup::WIDTH);
+    mCtrl = nullptr;
+    mSlots = nullptr;
+    mCapacity = mSize = mGrowthLeft = 0;
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef HAZARD_POINTERS_H
+#define HAZARD_POINTERS_H
+
+#include <atomic>
+#include <cstddef>
+
+/*
+* @brief Safe memory reclamation for
+*   lock-free containers. Before a thread
+*   dereferences a shared node it publishes
+*   the node's address in its hazard slot.
+*   Removed nodes are retired instead of
+*   deleted, and a retired node is only
+*   freed once no slot holds its address.
+*
+*   Every thread gets a single slot on
+*   its first use, which it gives back
+*   when it exits
+*/
+class HazardPointers {
+public:
+
+    /*
+    * @brief maximal number of threads
+    *   that can hold a slot at once
+    */
+    static constexpr std::size_t MAX_THREADS = 256;
+
+    /*
+    * @brief loads a pointer and protects
+    *   it with the calling thread's slot.
+    *   The pointer stays valid until the
+    *   slot is cleared or reused
+    *
+    * @param source shared pointer
+    *   to be loaded
+    *
+    * @throw std::runtime_error if more
+    *   than MAX_THREADS threads use
+    *   hazard pointers at once
+    *
+    * @return the protected pointer
+    */
+    template<typename Type>
+    static Type* protect(const std::atomic<Type*>& source);
+
+    /*
+    * @brief clears the calling
+    *   thread's slot
+    */
+    static void clear(void);
+
+    /*
+    * @brief hands a removed node over
+    *   for deletion once no thread
+    *   protects it anymore
+    *
+    * @param pointer the removed node
+    * @param deleter function that
+    *   deletes the node
+    */
+    static void retire(void* pointer, void (*deleter)(void*));
+
+private:
+
+    /*
+    * @brief returns the calling
+    *   thread's slot
+    */
+    static std::atomic<void*>& __slot__(void);
+
+};
+
+template<typename Type>
+Type* HazardPointers::protect(const std::atomic<Type*>& source) {
+    std::atomic<void*>& slot = __slot__();
+    Type* pointer = source.load(std::memory_order_relaxed);
+
+    /*
+     * The node could have been removed
+     * and retired between the load and
+     * the publication, so reload until
+     * the published value is still the
+     * current one.
+     */
+    for (;;) {
+        slot.store(pointer, std::memory_order_seq_cst);
+        Type* current = source.load(std::memory_order_seq_cst);
+        if (current == pointer) { return pointer; }
+        pointer = current;
+    }
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <cstddef>
+#include <utility>
+
+/*
+ * Heap algorithms on a plain array,
+ * shared by heap_sort and the priority
+ * queues. The element for which comp
+ * says that nothing goes after it ends
+ * up at index 0, so with std::less
+ * it's a max-heap.
+ *
+ * Every node has Arity children, the
+ * children of node i are stored at
+ * Arity * i + 1 ... Arity * i + Arity.
+ * Wider nodes make the heap shallower
+ * and keep the children on one cache line.
+ *
+ * The swap parameter lets the caller
+ * track where the elements move, which
+ * the indexed priority queue needs for
+ * its position map.
+ */
+
+/*
+ * @brief swaps two heap elements
+ */
+struct HeapSwap {
+    template<typename Type>
+    void operator()(Type* heap, std::size_t a, std::size_t b) const {
+        using std::swap;
+        swap(heap[a], heap[b]);
+    }
+};
+
+/*
+ * @brief moves an element up the heap
+ *  until its parent doesn't go after it
+ *
+ * @param heap the heap array
+ * @param idx index of the element
+ * @param comp comparator
+ * @param swap swaps two elements
+ */
+template<std::size_t Arity = 2, typename Type, typename Compare, typename Swap = HeapSwap>
+void heap_sift_up(Type* heap, std::size_t idx, Compare comp, Swap swap = Swap()) {
+    static_assert(Arity >= 2, "A heap node needs at least two children");
+    while (idx > 0) {
+        std::size_t parent = (idx - 1) / Arity;
+        if (!comp(heap[parent], heap[idx])) { break; }
+        swap(heap, parent, idx);
+        idx = parent;
+    }
+}
+
+/*
+ * @brief moves an element down the heap,
+ *  swapping it with its greatest child,
+ *  until no child goes after it
+ *
+ * @param heap the heap array
+ * @param size number of elements
+ *  in the heap
+ * @param idx index of the element
+ * @param comp comparator
+ * @param swap swaps two elements
+ */
+template<std::size_t Arity = 2, typename Type, typename Compare, typename Swap = HeapSwap>
+void heap_sift_down(Type* heap, std::size_t size, std::size_t idx,
+        Compare comp, Swap swap = Swap()) {
+    static_assert(Arity >= 2, "A heap node needs at least two children");
+    for (;;) {
+        std::size_t first = Arity * idx + 1;
+        if (first >= size) { break; }
+
+        std::size_t last = first + Arity < size ? first + Arity : size;
+        std::size_t maxIdx = first;
+        for (std::size_t child = first + 1; child < last; ++child)
+            if (comp(heap[maxIdx], heap[child])) { maxIdx = child; }
+
+        if (!comp(heap[idx], heap[maxIdx])) { break; }
+        swap(heap, idx, maxIdx);
+        idx = maxIdx;
+    }
+}
+
+/*
+ * @brief turns an array into a heap
+ *  in O(n) by sifting down every
+ *  parent, starting from the last one
+ *
+ * @param heap the array
+ * @param size length of the array
+ * @param comp comparator
+ * @param swap swaps two elements
+ */
+template<std::size_t Arity = 2, typename Type, typename Compare, typename Swap = HeapSwap>
+void heap_make(Type* heap, std::size_t size, Compare comp, Swap swap = Swap()) {
+    if (size < 2) { return; }
+    for (std::size_t idx = (size - 2) / Arity + 1; idx-- > 0; )
+        heap_sift_down<Arity>(heap, size, idx, comp, swap);
+}
+
+#endif
@@ -0,0 +1,503 @@
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+template<typename Type, typename Tag>
+class IntrusiveList;
+
+/*
+* @brief Links embedded in an element so
+*   it can be put on an IntrusiveList
+*   without a separate node. An element
+*   derives from one hook per list it can
+*   be on at the same time, the tags tell
+*   the hooks apart
+*
+*   Copying an element doesn't copy its
+*   links, the copy starts out unlinked.
+*   An element has to be removed from its
+*   list before it's destroyed
+*
+* @tparam Tag any type naming
+*   the hook
+*/
+template<typename Tag = void>
+class ListHook {
+public:
+
+    /*
+    * @brief initializes an
+    *   unlinked hook
+    */
+    ListHook(void) : mPrev(nullptr), mNext(nullptr) {}
+
+    ListHook(const ListHook&) : mPrev(nullptr), mNext(nullptr) {}
+    ListHook& operator=(const ListHook&) { return *this; }
+
+    /*
+    * @brief checks if the element
+    *   is on a list
+    *
+    * @return true if linked
+    */
+    bool isLinked(void) const { return mNext != nullptr; }
+
+private:
+
+    template<typename Type, typename ListTag>
+    friend class IntrusiveList;
+
+    ListHook* mPrev;
+    ListHook* mNext;
+
+};
+
+/*
+* @brief Doubly linked list of elements
+*   that carry their own links. Linking
+*   and unlinking are O(1) and never
+*   allocate, the list doesn't own or
+*   copy its elements. Any element can be
+*   unlinked in O(1) without searching
+*   for it, which is what LRU eviction
+*   needs.
+*
+*   The list is circular around a hook
+*   inside the list object, so there are
+*   no null checks on the hot paths
+*
+* @tparam Type The type parameter
+*   determining the type of the
+*   elements. It has to derive from
+*   ListHook<Tag>
+* @tparam Tag tag of the hook
+*   the list links through
+*/
+template<typename Type, typename Tag = void>
+class IntrusiveList {
+public:
+
+    using Hook = ListHook<Tag>;
+
+    /*
+    * @brief bidirectional iterator visiting
+    *   the elements from front to back.
+    *   Removing an element only invalidates
+    *   iterators to that element
+    */
+    class Iterator {
+    public:
+
+        using iterator_concept = std::bidirectional_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Type*;
+        using reference = Type&;
+
+        Iterator(void) : mHook(nullptr) {}
+        explicit Iterator(Hook* hook) : mHook(hook) {}
+
+        reference operator*(void) const { return IntrusiveList::__element__(mHook); }
+        pointer operator->(void) const { return &IntrusiveList::__element__(mHook); }
+
+        Iterator& operator++(void) {
+            mHook = mHook->mNext;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            mHook = mHook->mNext;
+            return tmp;
+        }
+
+        Iterator& operator--(void) {
+            mHook = mHook->mPrev;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator tmp = *this;
+            mHook = mHook->mPrev;
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const { return mHook == other.mHook; }
+
+    private:
+
+        Hook* mHook;
+
+    };
+
+    /*
+    * @brief initializes an
+    *   empty list object
+    */
+    IntrusiveList(void);
+
+    /*
+    * @brief unlinks all
+    *   of the elements
+    */
+    ~IntrusiveList(void);
+
+    /*
+    * @brief takes over the elements
+    *   of another list in O(1). The
+    *   other list is left empty
+    *
+    * @param other list to be
+    *   moved from
+    */
+    IntrusiveList(IntrusiveList&& other) noexcept;
+
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    /*
+    * @brief links an element
+    *   at the front of the list
+    *
+    * @throw std::runtime_error
+    *   if the element is already
+    *   on a list
+    *
+    * @param element element
+    *   to be linked
+    */
+    void pushFront(Type& element);
+
+    /*
+    * @brief links an element
+    *   at the back of the list
+    *
+    * @throw std::runtime_error
+    *   if the element is already
+    *   on a list
+    *
+    * @param element element
+    *   to be linked
+    */
+    void pushBack(Type& element);
+
+    /*
+    * @brief unlinks the element
+    *   at the front of the list
+    *
+    * @throw std::runtime_error
+    *   if the list is empty
+    *
+    * @return reference to the
+    *   unlinked element
+    */
+    Type& popFront(void);
+
+    /*
+    * @brief unlinks the element
+    *   at the back of the list
+    *
+    * @throw std::runtime_error
+    *   if the list is empty
+    *
+    * @return reference to the
+    *   unlinked element
+    */
+    Type& popBack(void);
+
+    /*
+    * @brief returns the element
+    *   at the front of the list
+    *
+    * @throw std::runtime_error
+    *   if the list is empty
+    *
+    * @return reference to the
+    *   first element
+    */
+    Type& front(void);
+
+    /*
+    * @brief returns the element
+    *   at the back of the list
+    *
+    * @throw std::runtime_error
+    *   if the list is empty
+    *
+    * @return reference to the
+    *   last element
+    */
+    Type& back(void);
+
+    /*
+    * @brief unlinks an element from
+    *   anywhere in the list in O(1).
+    *   The element has to be on this
+    *   list, an element on another list
+    *   can't be told apart in O(1)
+    *
+    * @throw std::runtime_error
+    *   if the element isn't on
+    *   any list
+    *
+    * @param element element
+    *   to be unlinked
+    */
+    void remove(Type& element);
+
+    /*
+    * @brief moves an element of this
+    *   list to the front in O(1)
+    *
+    * @throw std::runtime_error
+    *   if the element isn't on
+    *   any list
+    *
+    * @param element element
+    *   to be moved
+    */
+    void moveToFront(Type& element);
+
+    /*
+    * @brief moves an element of this
+    *   list to the back in O(1)
+    *
+    * @throw std::runtime_error
+    *   if the element isn't on
+    *   any list
+    *
+    * @param element element
+    *   to be moved
+    */
+    void moveToBack(Type& element);
+
+    /*
+    * @brief unlinks all of the
+    *   elements. The elements
+    *   themselves are untouched
+    */
+    void clear(void);
+
+    /*
+    * @brief checks if the
+    *   list is empty
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number
+    *   of elements in the list
+    *
+    * @return element count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief returns an iterator
+    *   to the front of the list
+    *
+    * @return iterator to the
+    *   first element
+    */
+    Iterator begin(void);
+
+    /*
+    * @brief returns an iterator
+    *   past the back of the list
+    *
+    * @return end iterator
+    */
+    Iterator end(void);
+
+private:
+
+    /*
+    * @brief returns the element
+    *   a hook is embedded in
+    */
+    static Type& __element__(Hook* hook);
+
+    /*
+    * @brief links a hook
+    *   in front of another one
+    */
+    void __link_before__(Hook* next, Hook* hook);
+
+    /*
+    * @brief unlinks a hook and
+    *   marks it as unlinked
+    */
+    void __unlink__(Hook* hook);
+
+    Hook mRoot;
+    std::size_t mSize;
+
+};
+
+template<typename Type, typename Tag>
+IntrusiveList<Type, Tag>::IntrusiveList(void) : mSize(0) {
+    mRoot.mPrev = mRoot.mNext = &mRoot;
+}
+
+template<typename Type, typename Tag>
+IntrusiveList<Type, Tag>::~IntrusiveList(void) {
+    this->clear();
+}
+
+template<typename Type, typename Tag>
+IntrusiveList<Type, Tag>::IntrusiveList(IntrusiveList&& other) noexcept : mSize(other.mSize) {
+    if (!other.mSize) {
+        mRoot.mPrev = mRoot.mNext = &mRoot;
+        return;
+    }
+
+    /*
+     * The first and the last element
+     * point at the other list's root,
+     * they're repointed at this one.
+     */
+    mRoot.mNext = other.mRoot.mNext;
+    mRoot.mPrev = other.mRoot.mPrev;
+    mRoot.mNext->mPrev = &mRoot;
+    mRoot.mPrev->mNext = &mRoot;
+    other.mRoot.mPrev = other.mRoot.mNext = &other.mRoot;
+    other.mSize = 0;
+}
+
+template<typename Type, typename Tag>
+void IntrusiveList<Type, Tag>::pushFront(Type& element) {
+    Hook* hook = &static_cast<Hook&>(element);
+    if (hook->isLinked())
+        throw std::runtime_error("Tried to push an element that's already on a list");
+    this->__link_before__(mRoot.mNext, hook);
+}
+
+template<typename Type, typename Tag>
+void IntrusiveList<Type, Tag>::pushBack(Type& element) {
+    Hook* hook = &static_cast<Hook&>(element);
+    if (hook->isLinked())
+        throw std::runtime_error("Tried to push an element that's already on a list");
+    this->__link_before__(&mRoot, hook);
+}
+
+template<typename Type, typename Tag>
+Type& IntrusiveList<Type, Tag>::popFront(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to pop from an empty list");
+    Hook* hook = mRoot.mNext;
+    this->__unlink__(hook);
+    return __element__(hook);
+}
+
+template<typename Type, typename Tag>
+Type& IntrusiveList<Type, Tag>::popBack(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to pop from an empty list");
+    Hook* hook = mRoot.mPrev;
+    this->__unlink__(hook);
+    return __element__(hook);
+}
+
+template<typename Type, typename Tag>
+Type& IntrusiveList<Type, Tag>::front(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to fetch the first element of an empty list");
+    return __element__(mRoot.mNext);
+}
+
+template<typename Type, typename Tag>
+Type& IntrusiveList<Type, Tag>::back(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to fetch the last element of an empty list");
+    return __element__(mRoot.mPrev);
+}
+
+template<typename Type, typename Tag>
+void IntrusiveList<Type, Tag>::remove(Type& element) {
+    Hook* hook = &static_cast<Hook&>(element);
+    if (!hook->isLinked())
+        throw std::runtime_error("Tried to remove an element that isn't on a list");
+    this->__unlink__(hook);
+}
+
+template<typename Type, typename Tag>
+void IntrusiveList<Type, Tag>::moveToFront(Type& element) {
+    Hook* hook = &static_cast<Hook&>(element);
+    if (!hook->isLinked())
+        throw std::runtime_error("Tried to move an element that isn't on a list");
+    if (mRoot.mNext == hook) { return; }
+    this->__unlink__(hook);
+    this->__link_before__(mRoot.mNext, hook);
+}
+
+template<typename Type, typename Tag>
+void IntrusiveList<Type, Tag>::moveToBack(Type& element) {
+    Hook* hook = &static_cast<Hook&>(element);
+    if (!hook->isLinked())
+        throw std::runtime_error("Tried to move an element that isn't on a list");
+    if (mRoot.mPrev == hook) { return; }
+    this->__unlink__(hook);
+    this->__link_before__(&mRoot, hook);
+}
+
+template<typename Type, typename Tag>
+void IntrusiveList<Type, Tag>::clear(void) {
+    Hook* hook = mRoot.mNext;
+    while (hook != &mRoot) {
+        Hook* next = hook->mNext;
+        hook->mPrev = hook->mNext = nullptr;
+        hook = next;
+    }
+    mRoot.mPrev = mRoot.mNext = &mRoot;
+    mSize = 0;
+}
+
+template<typename Type, typename Tag>
+bool IntrusiveList<Type, Tag>::isEmpty(void) {
+    return !mSize;
+}
+
+template<typename Type, typename Tag>
+std::size_t IntrusiveList<Type, Tag>::size(void) {
+    return mSize;
+}
+
+template<typename Type, typename Tag>
+typename IntrusiveList<Type, Tag>::Iterator IntrusiveList<Type, Tag>::begin(void) {
+    return Iterator(mRoot.mNext);
+}
+
+template<typename Type, typename Tag>
+typename IntrusiveList<Type, Tag>::Iterator IntrusiveList<Type, Tag>::end(void) {
+    return Iterator(&mRoot);
+}
+
+template<typename Type, typename Tag>
+Type& IntrusiveList<Type, Tag>::__element__(Hook* hook) {
+    return static_cast<Type&>(*hook);
+}
+
+template<typename Type, typename Tag>
+void IntrusiveList<Type, Tag>::__link_before__(Hook* next, Hook* hook) {
+    hook->mNext = next;
+    hook->mPrev = next->mPrev;
+    next->mPrev->mNext = hook;
+    next->mPrev = hook;
+    ++mSize;
+}
+
+template<typename Type, typename Tag>
+void IntrusiveList<Type, Tag>::__unlink__(Hook* hook) {
+    hook->mPrev->mNext = hook->mNext;
+    hook->mNext->mPrev = hook->mPrev;
+    hook->mPrev = hook->mNext = nullptr;
+    --mSize;
+}
+
+#endif
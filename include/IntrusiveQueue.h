@@ -0,0 +1,184 @@
+#ifndef INTRUSIVE_QUEUE_H
+#define INTRUSIVE_QUEUE_H
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "IntrusiveList.h"
+
+/*
+* @brief FIFO queue of elements that carry
+*   their own links, see ListHook. Enqueue
+*   and dequeue are O(1) and never allocate,
+*   the queue doesn't own or copy its
+*   elements. An element can also leave the
+*   queue from anywhere in O(1), e.g. when
+*   a waiting job gets cancelled
+*
+* @tparam Type The type parameter
+*   determining the type of the
+*   elements. It has to derive from
+*   ListHook<Tag>
+* @tparam Tag tag of the hook
+*   the queue links through
+*/
+template<typename Type, typename Tag = void>
+class IntrusiveQueue {
+public:
+
+    using Iterator = typename IntrusiveList<Type, Tag>::Iterator;
+
+    /*
+    * @brief adds an element
+    *   at the back of the
+    *   queue
+    *
+    * @throw std::runtime_error
+    *   if the element is already
+    *   on a list
+    *
+    * @param element element
+    *   to be added
+    */
+    void enqueue(Type& element);
+
+    /*
+    * @brief unlinks the element
+    *   at the front of the
+    *   queue
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return reference to the
+    *   unlinked element
+    */
+    Type& dequeue(void);
+
+    /*
+    * @brief returns the element
+    *   at the front of the queue
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return reference to the
+    *   first element
+    */
+    Type& front(void);
+
+    /*
+    * @brief returns the element
+    *   at the back of the queue
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return reference to the
+    *   last element
+    */
+    Type& back(void);
+
+    /*
+    * @brief unlinks an element from
+    *   anywhere in the queue in O(1).
+    *   The element has to be in
+    *   this queue
+    *
+    * @throw std::runtime_error
+    *   if the element isn't on
+    *   any list
+    *
+    * @param element element
+    *   to be unlinked
+    */
+    void remove(Type& element);
+
+    /*
+     * @brief returns true
+     *  if the queue is empty
+     *
+     * @return true if empty,
+     *  false otherwise
+     */
+    bool isEmpty(void);
+
+    /*
+     * @brief returns the number
+     *  of elements in the queue
+     *
+     * @return element count
+     */
+    std::size_t size(void);
+
+    /*
+     * @brief returns an iterator
+     *  to the front of the queue
+     *
+     * @return iterator to the
+     *  first element
+     */
+    Iterator begin(void);
+
+    /*
+     * @brief returns an iterator
+     *  past the back of the queue
+     *
+     * @return end iterator
+     */
+    Iterator end(void);
+
+private:
+
+    IntrusiveList<Type, Tag> mList;
+
+};
+
+template<typename Type, typename Tag>
+void IntrusiveQueue<Type, Tag>::enqueue(Type& element) {
+    mList.pushBack(element);
+}
+
+template<typename Type, typename Tag>
+Type& IntrusiveQueue<Type, Tag>::dequeue(void) {
+    if (mList.isEmpty())
+        throw std::runtime_error("Tried to dequeue an empty queue");
+    return mList.popFront();
+}
+
+template<typename Type, typename Tag>
+Type& IntrusiveQueue<Type, Tag>::front(void) {
+    if (mList.isEmpty())
+        throw std::runtime_error("Tried to fetch the first element of an empty queue");
+    return mList.front();
+}
+
+template<typename Type, typename Tag>
+Type& IntrusiveQueue<Type, Tag>::back(void) {
+    if (mList.isEmpty())
+        throw std::runtime_error("Tried to fetch the last element of an empty queue");
+    return mList.back();
+}
+
+template<typename Type, typename Tag>
+void IntrusiveQueue<Type, Tag>::remove(Type& element) {
+    mList.remove(element);
+}
+
+template<typename Type, typename Tag>
+bool IntrusiveQueue<Type, Tag>::isEmpty(void) { return mList.isEmpty(); }
+
+template<typename Type, typename Tag>
+std::size_t IntrusiveQueue<Type, Tag>::size(void) { return mList.size(); }
+
+template<typename Type, typename Tag>
+typename IntrusiveQueue<Type, Tag>::Iterator IntrusiveQueue<Type, Tag>::begin(void) {
+    return mList.begin();
+}
+
+template<typename Type, typename Tag>
+typename IntrusiveQueue<Type, Tag>::Iterator IntrusiveQueue<Type, Tag>::end(void) {
+    return mList.end();
+}
+
+#endif
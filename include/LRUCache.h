@@ -0,0 +1,572 @@
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "HashMap.h"
+#include "IntrusiveList.h"
+
+/*
+* @brief counters of
+*   a cache
+*/
+struct CacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+};
+
+/*
+* @brief Bounded cache that evicts the
+*   least recently used key once it's
+*   full. The entries are linked into an
+*   IntrusiveList from the most to the
+*   least recently used one and indexed
+*   by a HashMap, so get, put and evict
+*   are all O(1). A full cache reuses
+*   the evicted entry for the new key,
+*   so after warm-up nothing is allocated
+*
+* @tparam Key type of the keys
+* @tparam Value type of the values
+* @tparam Hash hash of the keys
+* @tparam Equal key equality
+*/
+template<typename Key, typename Value, typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>>
+class LRUCache {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty cache object
+    *
+    * @param capacity maximum
+    *   number of keys
+    *
+    * @throw std::invalid_argument
+    *   if the capacity is 0
+    */
+    explicit LRUCache(std::size_t capacity);
+
+    /*
+    * @brief frees all
+    *   of the entries
+    */
+    ~LRUCache(void);
+
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    /*
+    * @brief looks up a key and marks
+    *   it as the most recently used one
+    *
+    * @param key key to look up
+    *
+    * @return pointer to the value or
+    *   nullptr on a miss. It stays valid
+    *   until the key is evicted or removed
+    */
+    Value* get(const Key& key);
+
+    /*
+    * @brief inserts or updates a key and
+    *   marks it as the most recently used
+    *   one. A new key evicts the least
+    *   recently used one if the cache
+    *   is full
+    *
+    * @param key key to be stored
+    * @param value value of the key. An
+    *   rvalue is moved into the cache
+    */
+    void put(const Key& key, const Value& value);
+    void put(const Key& key, Value&& value);
+
+    /*
+    * @brief removes a key
+    *
+    * @param key key to be removed
+    *
+    * @return false if the key
+    *   wasn't in the cache
+    */
+    bool remove(const Key& key);
+
+    /*
+    * @brief checks if a key is cached
+    *   without touching its recency
+    *   or the counters
+    *
+    * @param key key to search for
+    *
+    * @return true if cached
+    */
+    bool contains(const Key& key);
+
+    /*
+    * @brief removes all of the keys.
+    *   The counters are kept
+    */
+    void clear(void);
+
+    /*
+    * @brief checks if the
+    *   cache is empty
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number
+    *   of cached keys
+    *
+    * @return key count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief returns the maximum
+    *   number of keys
+    *
+    * @return capacity
+    */
+    std::size_t capacity(void);
+
+    /*
+    * @brief returns the hit, miss
+    *   and eviction counters
+    *
+    * @return counters
+    */
+    CacheStats stats(void);
+
+private:
+
+    /*
+    * @brief a cached key, linked
+    *   into the recency list
+    */
+    struct Entry : ListHook<> {
+        template<typename V>
+        Entry(const Key& k, V&& v) : key(k), value(std::forward<V>(v)) {}
+
+        Key key;
+        Value value;
+    };
+
+    /*
+    * @brief shared part of both
+    *   put overloads
+    */
+    template<typename V>
+    void __put__(const Key& key, V&& value);
+
+    std::size_t mCapacity;
+    IntrusiveList<Entry> mRecency;
+    HashMap<Key, Entry*, Hash, Equal> mIndex;
+    CacheStats mStats;
+
+};
+
+/*
+* @brief LRUCache for concurrent use. The
+*   keys are split between independently
+*   locked shards by hash, so threads
+*   working on different shards never
+*   wait for each other. Every shard is
+*   an LRU cache of its own, so the
+*   eviction order is only exact within
+*   a shard
+*
+* @tparam Key type of the keys
+* @tparam Value type of the values
+* @tparam Hash hash of the keys
+* @tparam Equal key equality
+*/
+template<typename Key, typename Value, typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>>
+class ShardedLRUCache {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty cache object
+    *
+    * @param capacity maximum number of
+    *   keys, split between the shards
+    *   as evenly as possible
+    * @param shards number of shards,
+    *   rounded up to a power of two but
+    *   not beyond the capacity, so every
+    *   shard holds at least one key
+    *
+    * @throw std::invalid_argument
+    *   if the capacity is 0
+    */
+    explicit ShardedLRUCache(std::size_t capacity, std::size_t shards = 16);
+
+    /*
+    * @brief looks up a key and copies
+    *   its value out. The value can't be
+    *   handed out by pointer, another
+    *   thread could evict it right after
+    *
+    * @param key key to look up
+    * @param out destination
+    *   of the value
+    *
+    * @return false on a miss
+    */
+    bool get(const Key& key, Value& out);
+
+    /*
+    * @brief inserts or updates a key,
+    *   evicting the least recently used
+    *   key of its shard if the shard
+    *   is full
+    *
+    * @param key key to be stored
+    * @param value value of the key. An
+    *   rvalue is moved into the cache
+    */
+    void put(const Key& key, const Value& value);
+    void put(const Key& key, Value&& value);
+
+    /*
+    * @brief removes a key
+    *
+    * @param key key to be removed
+    *
+    * @return false if the key
+    *   wasn't in the cache
+    */
+    bool remove(const Key& key);
+
+    /*
+    * @brief checks if a key is cached
+    *   without touching its recency
+    *   or the counters
+    *
+    * @param key key to search for
+    *
+    * @return true if cached
+    */
+    bool contains(const Key& key);
+
+    /*
+    * @brief removes all of the keys.
+    *   The counters are kept
+    */
+    void clear(void);
+
+    /*
+    * @brief returns the number of
+    *   cached keys. Shards are locked
+    *   one after another, so it's only
+    *   a snapshot under concurrent use
+    *
+    * @return key count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief returns the maximum
+    *   number of keys
+    *
+    * @return capacity
+    */
+    std::size_t capacity(void);
+
+    /*
+    * @brief returns the number
+    *   of shards
+    *
+    * @return shard count
+    */
+    std::size_t shardCount(void);
+
+    /*
+    * @brief returns the counters summed
+    *   over the shards, a snapshot like
+    *   size
+    *
+    * @return counters
+    */
+    CacheStats stats(void);
+
+private:
+
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    /*
+    * @brief a lock and the keys it guards,
+    *   on its own cache lines so the locks
+    *   don't share them
+    */
+    struct alignas(CACHE_LINE) Shard {
+        explicit Shard(std::size_t capacity) : cache(capacity) {}
+
+        std::mutex mutex;
+        LRUCache<Key, Value, Hash, Equal> cache;
+    };
+
+    /*
+    * @brief returns the shard of a key.
+    *   The hash is mixed and its high bits
+    *   are used, the low bits of an identity
+    *   hash would pick shards by the last
+    *   digits of the key
+    */
+    Shard& __shard__(const Key& key);
+
+    std::vector<std::unique_ptr<Shard>> mShards;
+    std::size_t mCapacity;
+    unsigned int mShift;
+    [[no_unique_address]] Hash mHash;
+
+};
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+LRUCache<Key, Value, Hash, Equal>::LRUCache(std::size_t capacity) : mCapacity(capacity) {
+    if (!capacity)
+        throw std::invalid_argument("Cache has to hold at least one key");
+    mIndex.reserve(capacity);
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+LRUCache<Key, Value, Hash, Equal>::~LRUCache(void) {
+    this->clear();
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+Value* LRUCache<Key, Value, Hash, Equal>::get(const Key& key) {
+    Entry** entry = mIndex.find(key);
+    if (!entry) {
+        ++mStats.misses;
+        return nullptr;
+    }
+    ++mStats.hits;
+    mRecency.moveToFront(**entry);
+    return &(*entry)->value;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+void LRUCache<Key, Value, Hash, Equal>::put(const Key& key, const Value& value) {
+    this->__put__(key, value);
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+void LRUCache<Key, Value, Hash, Equal>::put(const Key& key, Value&& value) {
+    this->__put__(key, std::move(value));
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+template<typename V>
+void LRUCache<Key, Value, Hash, Equal>::__put__(const Key& key, V&& value) {
+    if (Entry** found = mIndex.find(key)) {
+        (*found)->value = std::forward<V>(value);
+        mRecency.moveToFront(**found);
+        return;
+    }
+
+    /*
+     * A full cache hands the least
+     * recently used entry over to the
+     * new key instead of freeing it
+     * and allocating another one. An
+     * entry is only linked once it's
+     * indexed, if anything throws on
+     * the way it's dropped.
+     */
+    Entry* entry;
+    if (mRecency.size() == mCapacity) {
+        entry = &mRecency.popBack();
+        mIndex.remove(entry->key);
+        ++mStats.evictions;
+        try {
+            entry->key = key;
+            entry->value = std::forward<V>(value);
+        } catch (...) {
+            delete entry;
+            throw;
+        }
+    } else {
+        entry = new Entry(key, std::forward<V>(value));
+    }
+
+    try {
+        mIndex.insert(key, entry);
+    } catch (...) {
+        delete entry;
+        throw;
+    }
+    mRecency.pushFront(*entry);
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+bool LRUCache<Key, Value, Hash, Equal>::remove(const Key& key) {
+    Entry** found = mIndex.find(key);
+    if (!found) { return false; }
+    Entry* entry = *found;
+    mIndex.remove(key);
+    mRecency.remove(*entry);
+    delete entry;
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+bool LRUCache<Key, Value, Hash, Equal>::contains(const Key& key) {
+    return mIndex.contains(key);
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+void LRUCache<Key, Value, Hash, Equal>::clear(void) {
+    while (!mRecency.isEmpty())
+        delete &mRecency.popFront();
+    mIndex.clear();
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+bool LRUCache<Key, Value, Hash, Equal>::isEmpty(void) {
+    return mRecency.isEmpty();
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+std::size_t LRUCache<Key, Value, Hash, Equal>::size(void) {
+    return mRecency.size();
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+std::size_t LRUCache<Key, Value, Hash, Equal>::capacity(void) {
+    return mCapacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+CacheStats LRUCache<Key, Value, Hash, Equal>::stats(void) {
+    return mStats;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+ShardedLRUCache<Key, Value, Hash, Equal>::ShardedLRUCache(std::size_t capacity, std::size_t shards) :
+    mCapacity(0),
+    mShift(64)
+{
+    if (!capacity)
+        throw std::invalid_argument("Cache has to hold at least one key");
+
+    std::size_t count = 1;
+    while (count < shards && count * 2 <= capacity) {
+        count <<= 1;
+        --mShift;
+    }
+
+    /*
+     * The first shards take one key
+     * of the remainder each, so the
+     * total is exactly the capacity.
+     */
+    std::size_t perShard = capacity / count, remainder = capacity % count;
+    mShards.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+        mShards.push_back(std::make_unique<Shard>(perShard + (i < remainder ? 1 : 0)));
+    mCapacity = capacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+bool ShardedLRUCache<Key, Value, Hash, Equal>::get(const Key& key, Value& out) {
+    Shard& shard = this->__shard__(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Value* value = shard.cache.get(key);
+    if (!value) { return false; }
+    out = *value;
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+void ShardedLRUCache<Key, Value, Hash, Equal>::put(const Key& key, const Value& value) {
+    Shard& shard = this->__shard__(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.cache.put(key, value);
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+void ShardedLRUCache<Key, Value, Hash, Equal>::put(const Key& key, Value&& value) {
+    Shard& shard = this->__shard__(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.cache.put(key, std::move(value));
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+bool ShardedLRUCache<Key, Value, Hash, Equal>::remove(const Key& key) {
+    Shard& shard = this->__shard__(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.remove(key);
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+bool ShardedLRUCache<Key, Value, Hash, Equal>::contains(const Key& key) {
+    Shard& shard = this->__shard__(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.contains(key);
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+void ShardedLRUCache<Key, Value, Hash, Equal>::clear(void) {
+    for (auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->cache.clear();
+    }
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+std::size_t ShardedLRUCache<Key, Value, Hash, Equal>::size(void) {
+    std::size_t size = 0;
+    for (auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size += shard->cache.size();
+    }
+    return size;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+std::size_t ShardedLRUCache<Key, Value, Hash, Equal>::capacity(void) {
+    return mCapacity;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+std::size_t ShardedLRUCache<Key, Value, Hash, Equal>::shardCount(void) {
+    return mShards.size();
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+CacheStats ShardedLRUCache<Key, Value, Hash, Equal>::stats(void) {
+    CacheStats total;
+    for (auto& shard : mShards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        CacheStats stats = shard->cache.stats();
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.evictions += stats.evictions;
+    }
+    return total;
+}
+
+template<typename Key, typename Value, typename Hash, typename Equal>
+typename ShardedLRUCache<Key, Value, Hash, Equal>::Shard&
+ShardedLRUCache<Key, Value, Hash, Equal>::__shard__(const Key& key) {
+    if (mShards.size() == 1) { return *mShards.front(); }
+    std::uint64_t hash = static_cast<std::uint64_t>(mHash(key)) * 0x9E3779B97F4A7C15ull;
+    return *mShards[hash >> mShift];
+}
+
+#endif
@@ -1,6 +1,16 @@
 #ifndef LIST_H
 #define LIST_H
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 #include "ListNode.h"
 
 /*
@@ -12,17 +22,112 @@
 * @tparam Type The type parameter
 *   determining the type of data
 *   stored in the container
+* @tparam Alloc allocator of the
+*   nodes, rebound to ListNode. With
+*   std::pmr::polymorphic_allocator the
+*   nodes can come from a PoolResource
+*   or an ArenaResource
 */
-template<typename Type>
+template<typename Type, typename Alloc = std::allocator<Type>>
 class List {
 public:
 
+    /*
+    * @brief forward iterator visiting
+    *   the values from front to back.
+    *   Removing a value only invalidates
+    *   iterators to that value
+    *
+    * @tparam Const true if the values
+    *   are read-only through it
+    */
+    template<bool Const>
+    class BasicIterator {
+    public:
+
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const Type*, Type*>;
+        using reference = std::conditional_t<Const, const Type&, Type&>;
+
+        BasicIterator(void) : mNode(nullptr) {}
+        explicit BasicIterator(ListNode<Type>* node) : mNode(node) {}
+
+        /*
+        * @brief a mutable iterator
+        *   converts to a const one
+        */
+        template<bool OtherConst> requires (Const && !OtherConst)
+        BasicIterator(const BasicIterator<OtherConst>& other) : 
+            mNode(other.mNode) 
+        {}
+
+        reference operator*(void) const { return mNode->getData(); }
+        pointer operator->(void) const { return &mNode->getData(); }
+
+        BasicIterator& operator++(void) {
+            mNode = mNode->getNext();
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
+            mNode = mNode->getNext();
+            return tmp;
+        }
+
+        bool operator==(const BasicIterator& other) const { return mNode == other.mNode; }
+
+    private:
+
+        template<bool>
+        friend class BasicIterator;
+
+        ListNode<Type>* mNode;
+
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
     /*
     * @brief initialises an
     *   empty list object
     */
     List(void);
 
+    /*
+    * @brief initialises an empty
+    *   list object that allocates
+    *   its nodes with the given
+    *   allocator
+    * 
+    * @param alloc allocator
+    */
+    explicit List(const Alloc& alloc);
+
+    /*
+    * @brief deletes all
+    *   of the nodes
+    */
+    ~List(void);
+
+    /*
+    * @brief takes over the nodes
+    *   of another list in O(1). The
+    *   other list is left empty
+    * 
+    * @param other list to be
+    *   moved from
+    */
+    List(List<Type, Alloc>&& other);
+    List<Type, Alloc>& operator=(List<Type, Alloc>&& other);
+
+    List(const List<Type, Alloc>&) = delete;
+    List<Type, Alloc>& operator=(const List<Type, Alloc>&) = delete;
+
     /*
     * @brief inserts data
     *   at the back of the list
@@ -30,30 +135,176 @@ public:
     * @param data value to be
     *   inserted into the list
     */
-	void insert(Type data);
+	void insert(const Type& data);
+	void insert(Type&& data);
+
+    /*
+    * @brief inserts data at the
+    *   back of the list in O(1)
+    * 
+    * @param data value to be
+    *   inserted into the list
+    */
+    void pushBack(const Type& data);
+    void pushBack(Type&& data);
+
+    /*
+    * @brief inserts data at the
+    *   front of the list in O(1)
+    * 
+    * @param data value to be
+    *   inserted into the list
+    */
+    void pushFront(const Type& data);
+    void pushFront(Type&& data);
+
+    /*
+    * @brief constructs a value in
+    *   place at the back of the list
+    * 
+    * @param args arguments passed
+    *   to the constructor of the value
+    * 
+    * @return reference to the
+    *   new value
+    */
+    template<typename... Args>
+    Type& emplaceBack(Args&&... args);
+
+    /*
+    * @brief constructs a value in
+    *   place at the front of the list
+    * 
+    * @param args arguments passed
+    *   to the constructor of the value
+    * 
+    * @return reference to the
+    *   new value
+    */
+    template<typename... Args>
+    Type& emplaceFront(Args&&... args);
+
+    /*
+    * @brief removes the value from
+    *   the front of the list and
+    *   moves it out
+    * 
+    * @throw std::runtime_error
+    *   if the list is empty
+    * 
+    * @return value removed from
+    *   the front of the list
+    */
+    Type popFront(void);
+
+    /*
+    * @brief inserts a range of
+    *   values at the back of the list.
+    *   The new nodes are linked with
+    *   each other first and attached
+    *   to the list in one step
+    * 
+    * @param first iterator to the
+    *   first value of the range
+    * @param last iterator past the
+    *   last value of the range
+    */
+    template<typename InputIt>
+    void insertRange(InputIt first, InputIt last);
+
+    /*
+    * @brief inserts a range of values
+    *   at the back of the list, the same
+    *   way as insertRange
+    * 
+    * @param values values to be
+    *   inserted into the list
+    */
+    void pushRange(std::span<const Type> values);
+
+    /*
+    * @brief removes up to count values
+    *   from the front of the list and
+    *   moves them into a buffer
+    * 
+    * @param out buffer for at
+    *   least count values
+    * @param count maximum number
+    *   of values to remove
+    * 
+    * @return number of values
+    *   removed, less than count if
+    *   the list runs out
+    */
+    std::size_t popN(Type* out, std::size_t count);
+
+    /*
+    * @brief moves all of the values
+    *   out from front to back, deleting
+    *   the nodes on the way
+    * 
+    * @param out output iterator
+    *   receiving the values
+    * 
+    * @return the output iterator
+    *   past the last value
+    */
+    template<typename OutputIt>
+    OutputIt drainTo(OutputIt out);
+
+    /*
+    * @brief moves all of the nodes
+    *   of another list to the back of
+    *   this list in O(1). The other
+    *   list is left empty. If the
+    *   allocators of the lists differ
+    *   the values are moved one by one
+    * 
+    * @param other list to be
+    *   appended
+    */
+    void splice(List<Type, Alloc>& other);
 
     /*
     * @brief removes a value
     *   from the list
     * 
     * @param key value to be
-    *   removed from the list
+    *   removed from the list. Can
+    *   be of any type comparable
+    *   with the stored values
     */
-	void remove(Type key);
+    template<typename Key>
+	void remove(const Key& key);
 
     /*
     * @brief finds a value
-    *   in the list
+    *   in the list. Every value has
+    *   its own node, so this is a
+    *   pointer chase with one compare
+    *   per node. UnrolledList keeps
+    *   the values in chunks and
+    *   compares them with SIMD
     * 
     * @param key value to search
-    *   for in the list
+    *   for in the list. Can be of
+    *   any type comparable with
+    *   the stored values, e.g. a
+    *   string_view for strings
     * 
     * @return pointer to a node
     *   that stores the key value.
     *   If there's no such node
     *   it returns nullptr
     */
-	ListNode<Type>* find(Type key);
+    template<typename Key>
+	ListNode<Type>* find(const Key& key);
+
+    /*
+    * @brief deletes all
+    *   of the nodes
+    */
+    void clear(void);
 
     /*
     * @brief checks if the 
@@ -63,43 +314,313 @@ public:
     */
 	bool isEmpty(void);
 
+    /*
+    * @brief returns the number
+    *   of elements in the list
+    * 
+    * @return element count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief sorts the list with a
+    *   bottom-up merge sort that only
+    *   relinks the nodes. The sort is
+    *   stable, doesn't allocate and
+    *   uses O(1) extra memory
+    * 
+    * @param comp comparator returning
+    *   true if the first argument goes
+    *   before the second one
+    */
+    template<typename Compare = std::less<Type>>
+    void sort(Compare comp = Compare());
+
+    /*
+    * @brief returns an iterator
+    *   to the front of the list
+    * 
+    * @return iterator to the
+    *   first value
+    */
+    Iterator begin(void);
+    ConstIterator begin(void) const;
+
+    /*
+    * @brief returns an iterator
+    *   past the back of the list
+    * 
+    * @return end iterator
+    */
+    Iterator end(void);
+    ConstIterator end(void) const;
+
 private:
 
+    /*
+    * @brief cuts the list after the
+    *   given number of nodes
+    * 
+    * @param node first node of the run
+    * @param length length of the run
+    * 
+    * @return first node after the run
+    */
+    static ListNode<Type>* __split__(ListNode<Type>* node, std::size_t length);
+
+    using NodeAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<ListNode<Type>>;
+    using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+    /*
+    * @brief allocates and
+    *   constructs a node
+    * 
+    * @param args arguments passed
+    *   to the constructor of the node
+    */
+    template<typename... Args>
+    ListNode<Type>* __new_node__(Args&&... args);
+
+    /*
+    * @brief destroys and
+    *   frees a node
+    */
+    void __delete_node__(ListNode<Type>* node);
+
+    /*
+    * @brief links a node at
+    *   the back of the list
+    */
+    void __link_back__(ListNode<Type>* node);
+
+    /*
+    * @brief links a node at
+    *   the front of the list
+    */
+    void __link_front__(ListNode<Type>* node);
+
 	ListNode<Type>* mHead;
+    ListNode<Type>* mTail;
+    std::size_t mSize;
+    [[no_unique_address]] NodeAllocator mAlloc;
 
 };
 
-template<typename Type>
-List<Type>::List(void) : mHead(nullptr) {}
-
-template<typename Type>
-void List<Type>::insert(Type data) {
-    if (!mHead) {
-        mHead = new ListNode<Type>(data);
-    } else {
-        ListNode<Type>* ptr = mHead;
-        while (ptr->getNext())
-            ptr = ptr->getNext();
-        ptr->setNext(new ListNode<Type>(data));
+template<typename Type, typename Alloc>
+List<Type, Alloc>::List(void) : mHead(nullptr), mTail(nullptr), mSize(0) {}
+
+template<typename Type, typename Alloc>
+List<Type, Alloc>::List(const Alloc& alloc) : 
+    mHead(nullptr),
+    mTail(nullptr),
+    mSize(0),
+    mAlloc(alloc)
+{}
+
+template<typename Type, typename Alloc>
+List<Type, Alloc>::~List(void) {
+    this->clear();
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::clear(void) {
+    while (mHead) {
+        ListNode<Type>* tmp = mHead;
+        mHead = mHead->getNext();
+        this->__delete_node__(tmp);
     }
+    mTail = nullptr;
+    mSize = 0;
+}
+
+template<typename Type, typename Alloc>
+List<Type, Alloc>::List(List<Type, Alloc>&& other) : 
+    mHead(other.mHead),
+    mTail(other.mTail),
+    mSize(other.mSize),
+    mAlloc(std::move(other.mAlloc))
+{
+    other.mHead = other.mTail = nullptr;
+    other.mSize = 0;
 }
 
-template<typename Type>
-ListNode<Type>* List<Type>::find(Type key) {
+template<typename Type, typename Alloc>
+List<Type, Alloc>& List<Type, Alloc>::operator=(List<Type, Alloc>&& other) {
+    if (&other == this) { return *this; }
+    this->clear();
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value)
+        mAlloc = std::move(other.mAlloc);
+    this->splice(other);
+    return *this;
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::insert(const Type& data) {
+    this->pushBack(data);
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::insert(Type&& data) {
+    this->pushBack(std::move(data));
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::pushBack(const Type& data) {
+    this->__link_back__(this->__new_node__(data));
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::pushBack(Type&& data) {
+    this->__link_back__(this->__new_node__(std::move(data)));
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::pushFront(const Type& data) {
+    this->__link_front__(this->__new_node__(data));
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::pushFront(Type&& data) {
+    this->__link_front__(this->__new_node__(std::move(data)));
+}
+
+template<typename Type, typename Alloc>
+template<typename... Args>
+Type& List<Type, Alloc>::emplaceBack(Args&&... args) {
+    ListNode<Type>* node = this->__new_node__(std::in_place, std::forward<Args>(args)...);
+    this->__link_back__(node);
+    return node->getData();
+}
+
+template<typename Type, typename Alloc>
+template<typename... Args>
+Type& List<Type, Alloc>::emplaceFront(Args&&... args) {
+    ListNode<Type>* node = this->__new_node__(std::in_place, std::forward<Args>(args)...);
+    this->__link_front__(node);
+    return node->getData();
+}
+
+template<typename Type, typename Alloc>
+Type List<Type, Alloc>::popFront(void) {
+    if (!mHead)
+        throw std::runtime_error("Tried to pop from an empty list");
+
+    ListNode<Type>* node = mHead;
+    mHead = mHead->getNext();
+    if (!mHead) { mTail = nullptr; }
+    --mSize;
+
+    Type data = std::move(node->getData());
+    this->__delete_node__(node);
+    return data;
+}
+
+template<typename Type, typename Alloc>
+template<typename InputIt>
+void List<Type, Alloc>::insertRange(InputIt first, InputIt last) {
+    if (first == last) return;
+
+    ListNode<Type>* head = this->__new_node__(*first);
+    ListNode<Type>* tail = head;
+    std::size_t count = 1;
+    try {
+        for (++first; first != last; ++first, ++count) {
+            tail->setNext(this->__new_node__(*first));
+            tail = tail->getNext();
+        }
+    } catch (...) {
+        while (head) {
+            ListNode<Type>* tmp = head;
+            head = head->getNext();
+            this->__delete_node__(tmp);
+        }
+        throw;
+    }
+
+    if (!mHead) { mHead = head; }
+    else { mTail->setNext(head); }
+    mTail = tail;
+    mSize += count;
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::pushRange(std::span<const Type> values) {
+    this->insertRange(values.begin(), values.end());
+}
+
+template<typename Type, typename Alloc>
+std::size_t List<Type, Alloc>::popN(Type* out, std::size_t count) {
+    std::size_t popped = 0;
+    for (; popped < count && mHead; ++popped) {
+        ListNode<Type>* node = mHead;
+        out[popped] = std::move(node->getData());
+        mHead = mHead->getNext();
+        --mSize;
+        this->__delete_node__(node);
+    }
+    if (!mHead) { mTail = nullptr; }
+    return popped;
+}
+
+template<typename Type, typename Alloc>
+template<typename OutputIt>
+OutputIt List<Type, Alloc>::drainTo(OutputIt out) {
+    while (mHead) {
+        ListNode<Type>* node = mHead;
+        *out++ = std::move(node->getData());
+        mHead = mHead->getNext();
+        --mSize;
+        this->__delete_node__(node);
+    }
+    mTail = nullptr;
+    return out;
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::splice(List<Type, Alloc>& other) {
+    if (&other == this || !other.mHead) return;
+
+    /*
+     * Nodes can only change hands
+     * if both lists free them the
+     * same way. Otherwise the values
+     * are moved over one by one.
+     */
+    if (mAlloc != other.mAlloc) {
+        while (other.mHead)
+            this->pushBack(other.popFront());
+        return;
+    }
+
+    if (!mHead) { mHead = other.mHead; }
+    else { mTail->setNext(other.mHead); }
+    mTail = other.mTail;
+    mSize += other.mSize;
+
+    other.mHead = other.mTail = nullptr;
+    other.mSize = 0;
+}
+
+template<typename Type, typename Alloc>
+template<typename Key>
+ListNode<Type>* List<Type, Alloc>::find(const Key& key) {
     ListNode<Type>* ptr = mHead;
     while (ptr && ptr->getData() != key)
         ptr = ptr->getNext();
     return ptr;
 }
 
-template<typename Type>
-void List<Type>::remove(Type key) {
+template<typename Type, typename Alloc>
+template<typename Key>
+void List<Type, Alloc>::remove(const Key& key) {
     if (!mHead) return;
 
     if (mHead->getData() == key) {
         ListNode<Type>* tmp = mHead;
         mHead = mHead->getNext();
-        delete tmp;
+        if (!mHead) { mTail = nullptr; }
+        this->__delete_node__(tmp);
+        --mSize;
         return;
     }
 
@@ -112,12 +633,142 @@ void List<Type>::remove(Type key) {
 
     ListNode<Type>* tmp = ptr->getNext();
     ptr->setNext(ptr->getNext()->getNext());
-    delete tmp;
+    if (tmp == mTail) { mTail = ptr; }
+    this->__delete_node__(tmp);
+    --mSize;
 }
 
-template<typename Type>
-bool List<Type>::isEmpty(void) {
+template<typename Type, typename Alloc>
+bool List<Type, Alloc>::isEmpty(void) {
     return !mHead;
 }
 
+template<typename Type, typename Alloc>
+std::size_t List<Type, Alloc>::size(void) {
+    return mSize;
+}
+
+template<typename Type, typename Alloc>
+typename List<Type, Alloc>::Iterator List<Type, Alloc>::begin(void) {
+    return Iterator(mHead);
+}
+
+template<typename Type, typename Alloc>
+typename List<Type, Alloc>::Iterator List<Type, Alloc>::end(void) {
+    return Iterator(nullptr);
+}
+
+template<typename Type, typename Alloc>
+typename List<Type, Alloc>::ConstIterator List<Type, Alloc>::begin(void) const {
+    return ConstIterator(mHead);
+}
+
+template<typename Type, typename Alloc>
+typename List<Type, Alloc>::ConstIterator List<Type, Alloc>::end(void) const {
+    return ConstIterator(nullptr);
+}
+
+template<typename Type, typename Alloc>
+template<typename Compare>
+void List<Type, Alloc>::sort(Compare comp) {
+    std::size_t length = mSize;
+
+    /*
+     * Merge neighbouring runs of
+     * doubling width. Each pass cuts
+     * two runs off the rest of the
+     * list, merges them and links
+     * the result after the last
+     * merged node.
+     */
+    for (std::size_t width = 1; width < length; width *= 2) {
+        ListNode<Type>* rest = mHead;
+        ListNode<Type>* last = nullptr;
+        mHead = nullptr;
+
+        while (rest) {
+            ListNode<Type>* left = rest;
+            ListNode<Type>* right = __split__(left, width);
+            rest = __split__(right, width);
+
+            while (left || right) {
+                ListNode<Type>* next;
+
+                /*
+                 * Take from the right run only if
+                 * it's strictly smaller, which
+                 * keeps equal values in order.
+                 */
+                if (!left || (right && comp(right->getData(), left->getData()))) {
+                    next = right;
+                    right = right->getNext();
+                } else {
+                    next = left;
+                    left = left->getNext();
+                }
+
+                if (last) { last->setNext(next); }
+                else { mHead = next; }
+                last = next;
+            }
+        }
+        last->setNext(nullptr);
+        mTail = last;
+    }
+}
+
+template<typename Type, typename Alloc>
+ListNode<Type>* List<Type, Alloc>::__split__(ListNode<Type>* node, std::size_t length) {
+    for (std::size_t i = 1; node && i < length; ++i)
+        node = node->getNext();
+    if (!node) { return nullptr; }
+
+    ListNode<Type>* rest = node->getNext();
+    node->setNext(nullptr);
+    return rest;
+}
+
+template<typename Type, typename Alloc>
+template<typename... Args>
+ListNode<Type>* List<Type, Alloc>::__new_node__(Args&&... args) {
+    ListNode<Type>* node = NodeTraits::allocate(mAlloc, 1);
+    try {
+        NodeTraits::construct(mAlloc, node, std::forward<Args>(args)...);
+    } catch (...) {
+        NodeTraits::deallocate(mAlloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::__delete_node__(ListNode<Type>* node) {
+    NodeTraits::destroy(mAlloc, node);
+    NodeTraits::deallocate(mAlloc, node, 1);
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::__link_back__(ListNode<Type>* node) {
+    if (!mHead) { mHead = node; }
+    else { mTail->setNext(node); }
+    mTail = node;
+    ++mSize;
+}
+
+template<typename Type, typename Alloc>
+void List<Type, Alloc>::__link_front__(ListNode<Type>* node) {
+    node->setNext(mHead);
+    mHead = node;
+    if (!mTail) { mTail = node; }
+    ++mSize;
+}
+
+/*
+ * Read-only code gets the same
+ * ranges support through the
+ * const overloads.
+ */
+static_assert(std::ranges::forward_range<List<int>>);
+static_assert(std::ranges::forward_range<const List<int>>);
+
 #endif
@@ -1,6 +1,8 @@
 #ifndef LIST_NODE_H
 #define LIST_NODE_H
 
+#include <utility>
+
 /*
 * @brief A generic container
 *   class that stores data
@@ -18,12 +20,24 @@ public:
 
     /*
     * @brief initialises a node
-    *   object
+    *   object, copying or moving
+    *   the initial value in
     * 
     * @param data initial value
     *   stored in the node
     */
-    ListNode(Type data);
+    ListNode(const Type& data);
+    ListNode(Type&& data);
+
+    /*
+    * @brief initialises a node object
+    *   constructing the value in place
+    * 
+    * @param args arguments passed
+    *   to the constructor of the value
+    */
+    template<typename... Args>
+    explicit ListNode(std::in_place_t, Args&&... args);
 
     /*
     * @brief sets the data
@@ -32,7 +46,8 @@ public:
     * @param data data value
     *   to be stored in the node
     */
-    void setData(Type data);
+    void setData(const Type& data);
+    void setData(Type&& data);
 
     /*
     * @brief sets the next node that
@@ -69,7 +84,17 @@ private:
 };
 
 template<typename Type>
-ListNode<Type>::ListNode(Type data) : mData(data), mNext(nullptr) {}
+ListNode<Type>::ListNode(const Type& data) : mData(data), mNext(nullptr) {}
+
+template<typename Type>
+ListNode<Type>::ListNode(Type&& data) : mData(std::move(data)), mNext(nullptr) {}
+
+template<typename Type>
+template<typename... Args>
+ListNode<Type>::ListNode(std::in_place_t, Args&&... args) :
+    mData(std::forward<Args>(args)...),
+    mNext(nullptr)
+{}
 
 template<typename Type>
 void ListNode<Type>::setNext(ListNode<Type>* next) { mNext = next; }
@@ -78,7 +103,10 @@ template<typename Type>
 ListNode<Type>* ListNode<Type>::getNext(void) { return mNext; }
 
 template<typename Type>
-void ListNode<Type>::setData(Type data) { mData = data; }
+void ListNode<Type>::setData(const Type& data) { mData = data; }
+
+template<typename Type>
+void ListNode<Type>::setData(Type&& data) { mData = std::move(data); }
 
 template<typename Type>
 Type& ListNode<Type>::getData(void) { return mData; }
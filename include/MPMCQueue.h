@@ -0,0 +1,289 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/*
+* @brief Bounded lock-free queue for
+*   any number of producer and consumer
+*   threads, after Dmitry Vyukov's
+*   bounded MPMC queue.
+*
+*   Every slot carries a sequence number
+*   that says whose turn it is. A producer
+*   claims the slot at the tail once its
+*   sequence equals the tail position, a
+*   consumer claims the slot at the head
+*   once its sequence is one past the head
+*   position. Claiming is a single CAS on
+*   the shared index, after which the slot
+*   is owned exclusively
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+*/
+template<typename Type>
+class MPMCQueue {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty queue object
+    *
+    * @param capacity capacity of
+    *   the queue, rounded up to
+    *   a power of two
+    */
+    explicit MPMCQueue(std::size_t capacity);
+
+    /*
+    * @brief destroys the remaining
+    *   values and frees the buffer.
+    *   No thread may use the queue
+    *   anymore
+    */
+    ~MPMCQueue(void);
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    /*
+    * @brief adds a value at the
+    *   back of the queue
+    *
+    * @throw std::runtime_error
+    *   if the queue is full
+    *
+    * @param data value to be
+    *   added to the queue
+    */
+    void enqueue(Type data);
+
+    /*
+    * @brief returns a value from the
+    *   front of the queue and deletes
+    *   it from the queue
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return value fetched from
+    *   the front of the queue
+    */
+    Type dequeue(void);
+
+    /*
+    * @brief adds a value at the
+    *   back of the queue if there's
+    *   room for it
+    *
+    * @param data value to be
+    *   added to the queue
+    *
+    * @return false if the
+    *   queue is full
+    */
+    bool tryEnqueue(Type data);
+
+    /*
+    * @brief moves the value from the
+    *   front of the queue into out
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the
+    *   queue is empty
+    */
+    bool tryDequeue(Type& out);
+
+    /*
+    * @brief checks if the queue is
+    *   empty. The answer may be stale
+    *   by the time it's returned
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the capacity
+    *   of the queue
+    *
+    * @return capacity
+    */
+    std::size_t capacity(void);
+
+private:
+
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    /*
+     * @brief a slot of the ring
+     *  and its sequence number
+     */
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        alignas(Type) unsigned char storage[sizeof(Type)];
+
+        Type* value(void) { return reinterpret_cast<Type*>(storage); }
+    };
+
+    /*
+     * @brief claims the slot for
+     *  the next value to be dequeued
+     *
+     * @return the claimed slot or
+     *  nullptr if the queue is empty
+     */
+    Cell* __claim_head__(std::size_t& pos);
+
+    alignas(CACHE_LINE) std::atomic<std::size_t> mTail;
+    alignas(CACHE_LINE) std::atomic<std::size_t> mHead;
+    alignas(CACHE_LINE) Cell* mBuffer;
+    std::size_t mMask;
+
+};
+
+template<typename Type>
+MPMCQueue<Type>::MPMCQueue(std::size_t capacity) : mTail(0), mHead(0) {
+
+    /*
+     * The algorithm needs at least two
+     * slots, with a single one an empty
+     * and a full slot look the same.
+     */
+    std::size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+    mBuffer = new Cell[rounded];
+    mMask = rounded - 1;
+
+    for (std::size_t i = 0; i < rounded; ++i)
+        mBuffer[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<typename Type>
+MPMCQueue<Type>::~MPMCQueue(void) {
+    std::size_t tail = mTail.load(std::memory_order_relaxed);
+    for (std::size_t pos = mHead.load(std::memory_order_relaxed); pos != tail; ++pos)
+        mBuffer[pos & mMask].value()->~Type();
+    delete[] mBuffer;
+}
+
+template<typename Type>
+void MPMCQueue<Type>::enqueue(Type data) {
+    if (!this->tryEnqueue(std::move(data)))
+        throw std::runtime_error("Tried to enqueue into a full queue");
+}
+
+template<typename Type>
+Type MPMCQueue<Type>::dequeue(void) {
+    std::size_t pos;
+    Cell* cell = this->__claim_head__(pos);
+    if (!cell)
+        throw std::runtime_error("Tried to dequeue an empty queue");
+
+    Type data = std::move(*cell->value());
+    cell->value()->~Type();
+    cell->sequence.store(pos + mMask + 1, std::memory_order_release);
+    return data;
+}
+
+template<typename Type>
+bool MPMCQueue<Type>::tryEnqueue(Type data) {
+    Cell* cell;
+    std::size_t pos = mTail.load(std::memory_order_relaxed);
+
+    for (;;) {
+        cell = &mBuffer[pos & mMask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+        /*
+         * The slot is free for this
+         * position, try to claim it.
+         * On failure pos holds the
+         * current tail.
+         */
+        if (diff == 0) {
+            if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+
+        /*
+         * The slot still holds the value
+         * from one lap ago, so the queue
+         * is full.
+         */
+        } else if (diff < 0) {
+            return false;
+
+        /*
+         * Another producer got here
+         * first, catch up with it.
+         */
+        } else {
+            pos = mTail.load(std::memory_order_relaxed);
+        }
+    }
+
+    new (cell->value()) Type(std::move(data));
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename Type>
+bool MPMCQueue<Type>::tryDequeue(Type& out) {
+    std::size_t pos;
+    Cell* cell = this->__claim_head__(pos);
+    if (!cell) { return false; }
+
+    out = std::move(*cell->value());
+    cell->value()->~Type();
+
+    /*
+     * Hand the slot to the producer
+     * that will use it on the next lap.
+     */
+    cell->sequence.store(pos + mMask + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename Type>
+bool MPMCQueue<Type>::isEmpty(void) {
+    std::size_t pos = mHead.load(std::memory_order_acquire);
+    return mBuffer[pos & mMask].sequence.load(std::memory_order_acquire) != pos + 1;
+}
+
+template<typename Type>
+std::size_t MPMCQueue<Type>::capacity(void) {
+    return mMask + 1;
+}
+
+template<typename Type>
+typename MPMCQueue<Type>::Cell* MPMCQueue<Type>::__claim_head__(std::size_t& pos) {
+    pos = mHead.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Cell* cell = &mBuffer[pos & mMask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            if (mHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return cell;
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = mHead.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+/*
+* @brief Read-only or writable memory
+*   mapping of a whole file. The mapping
+*   is released when the object is
+*   destroyed
+*/
+class MappedFile {
+public:
+
+    /*
+    * @brief how the file is mapped
+    *
+    *   Read    - read-only view
+    *   Private - writable, but the writes
+    *             never reach the file
+    *             (copy-on-write)
+    *   Shared  - writable, the writes
+    *             go to the file
+    */
+    enum class Mode {
+        Read,
+        Private,
+        Shared
+    };
+
+    /*
+    * @brief maps an existing file
+    *
+    * @param path path to the file
+    * @param mode mapping mode
+    *
+    * @throw std::runtime_error if the
+    *   file can't be opened or mapped
+    */
+    MappedFile(const std::string& path, Mode mode);
+
+    /*
+    * @brief unmaps the file
+    */
+    ~MappedFile(void);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /*
+    * @brief returns the start of
+    *   the mapping. nullptr if the
+    *   file is empty
+    *
+    * @return pointer to the first
+    *   byte of the file
+    */
+    void* data(void);
+
+    /*
+    * @brief returns the size of
+    *   the mapped file
+    *
+    * @return size in bytes
+    */
+    std::size_t size(void) const;
+
+    /*
+    * @brief tells the kernel that the
+    *   mapping will be read front to
+    *   back, so it reads ahead
+    *   aggressively
+    */
+    void adviseSequential(void);
+
+private:
+
+    void* mData;
+    std::size_t mSize;
+
+};
+
+#endif
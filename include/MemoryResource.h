@@ -0,0 +1,173 @@
+#ifndef MEMORY_RESOURCE_H
+#define MEMORY_RESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+/*
+* Memory resources for the allocator-aware
+* containers. They plug in through
+* std::pmr::polymorphic_allocator, e.g.
+*
+*   PoolResource pool(sizeof(ListNode<int>));
+*   List<int, std::pmr::polymorphic_allocator<int>> list(&pool);
+*
+* Neither of them is thread-safe, they're
+* meant to be owned by a single thread or
+* a single request.
+*/
+
+/*
+* @brief Pool of fixed size blocks. Freed
+*   blocks go onto a free-list and are
+*   handed out again first, so a container
+*   with a lot of insert/remove churn stops
+*   calling malloc once it's warmed up.
+*   Blocks are carved out of chunks taken
+*   from the upstream resource. Requests
+*   that don't fit a block are passed to
+*   the upstream resource as they are
+*/
+class PoolResource : public std::pmr::memory_resource {
+public:
+
+    /*
+    * @brief creates an empty pool
+    *
+    * @param blockSize size of a block,
+    *   usually the size of a node
+    * @param blocksPerChunk number of
+    *   blocks taken from upstream at once
+    * @param upstream resource the
+    *   chunks are taken from
+    */
+    explicit PoolResource(std::size_t blockSize, std::size_t blocksPerChunk = 256,
+            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    /*
+    * @brief gives all of the
+    *   chunks back to upstream
+    */
+    ~PoolResource(void) override;
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    /*
+    * @brief gives all of the chunks back
+    *   to upstream, whether or not their
+    *   blocks were deallocated
+    */
+    void release(void);
+
+    /*
+    * @brief returns the size
+    *   of a block
+    *
+    * @return block size
+    */
+    std::size_t blockSize(void) const;
+
+protected:
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+
+    /*
+    * @brief carves a new chunk
+    *   into free blocks
+    */
+    void __refill__(void);
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::pmr::memory_resource* mUpstream;
+    std::size_t mBlockSize;
+    std::size_t mBlockAlign;
+    std::size_t mBlocksPerChunk;
+    FreeBlock* mFree;
+    void* mChunks;
+
+};
+
+/*
+* @brief Monotonic arena. Allocation bumps
+*   a pointer through the current chunk,
+*   deallocation does nothing, and all of
+*   the memory is given back at once by
+*   release or the destructor. Freeing a
+*   whole container this way costs one
+*   upstream call per chunk no matter how
+*   many nodes it had. The chunks double
+*   in size as the arena grows
+*/
+class ArenaResource : public std::pmr::memory_resource {
+public:
+
+    /*
+    * @brief creates an empty arena
+    *
+    * @param initialSize size of
+    *   the first chunk
+    * @param upstream resource the
+    *   chunks are taken from
+    */
+    explicit ArenaResource(std::size_t initialSize = 4096,
+            std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    /*
+    * @brief gives all of the
+    *   chunks back to upstream
+    */
+    ~ArenaResource(void) override;
+
+    ArenaResource(const ArenaResource&) = delete;
+    ArenaResource& operator=(const ArenaResource&) = delete;
+
+    /*
+    * @brief gives all of the chunks
+    *   back to upstream. Everything
+    *   allocated from the arena is
+    *   gone afterwards
+    */
+    void release(void);
+
+    /*
+    * @brief returns the number of
+    *   bytes handed out since the
+    *   last release
+    *
+    * @return byte count
+    */
+    std::size_t allocated(void) const;
+
+protected:
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+
+    /*
+    * @brief takes a chunk that fits
+    *   at least the given request
+    */
+    void __grow__(std::size_t bytes, std::size_t alignment);
+
+    std::pmr::memory_resource* mUpstream;
+    std::size_t mInitialSize;
+    std::size_t mNextSize;
+    std::size_t mAllocated;
+    char* mCursor;
+    char* mEnd;
+    void* mChunks;
+
+};
+
+#endif
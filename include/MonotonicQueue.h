@@ -0,0 +1,398 @@
+#ifndef MONOTONIC_QUEUE_H
+#define MONOTONIC_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <stdexcept>
+
+#include "Deque.h"
+
+/*
+* @brief Queue of samples that answers
+*   "what's the best sample still in the
+*   queue" in O(1). A sample that is older
+*   than a sample at least as good can
+*   never be the answer again, so it's
+*   dropped as soon as the better one
+*   arrives. The samples that are left
+*   are ordered best first, so the answer
+*   is always at the front. Every sample
+*   is added and dropped once, which
+*   makes push and pop O(1) amortized.
+*
+*   Every sample gets a position, the
+*   number of samples pushed before it.
+*   Samples expire in push order, either
+*   one at a time or all before a given
+*   position
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+* @tparam Compare comparator returning
+*   true if the first argument is better
+*   than the second one. std::less keeps
+*   the minimum, std::greater the maximum
+*/
+template<typename Type, typename Compare = std::less<Type>>
+class MonotonicQueue {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty queue object
+    *
+    * @param comp comparator
+    */
+    explicit MonotonicQueue(Compare comp = Compare());
+
+    /*
+    * @brief adds the newest sample
+    *
+    * @param value value of
+    *   the sample
+    */
+    void push(const Type& value);
+
+    /*
+    * @brief adds samples
+    *   oldest first
+    *
+    * @param values values of
+    *   the samples
+    */
+    void pushRange(std::span<const Type> values);
+
+    /*
+    * @brief expires the
+    *   oldest sample
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    */
+    void pop(void);
+
+    /*
+    * @brief expires all of the samples
+    *   before the given position
+    *
+    * @param position position of the
+    *   oldest sample to be kept
+    */
+    void popExpired(std::uint64_t position);
+
+    /*
+    * @brief returns the best sample
+    *   still in the queue
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return reference to the
+    *   best sample
+    */
+    const Type& top(void);
+
+    /*
+    * @brief returns the position the
+    *   next sample will get, which is
+    *   also the number of samples
+    *   pushed so far
+    *
+    * @return position
+    */
+    std::uint64_t position(void);
+
+    /*
+    * @brief skips positions without
+    *   pushing samples. The queue
+    *   must be empty
+    *
+    * @param count number of
+    *   positions to skip
+    */
+    void skip(std::uint64_t count);
+
+    /*
+    * @brief expires all
+    *   of the samples
+    */
+    void clear(void);
+
+    /*
+    * @brief checks if the
+    *   queue is empty
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number of samples
+    *   that haven't expired, including the
+    *   ones that were dropped
+    *
+    * @return sample count
+    */
+    std::size_t size(void);
+
+private:
+
+    /*
+    * @brief a sample that
+    *   can still be the best
+    */
+    struct Entry {
+        std::uint64_t position;
+        Type value;
+    };
+
+    Deque<Entry> mEntries;
+    std::uint64_t mBegin;
+    std::uint64_t mEnd;
+    [[no_unique_address]] Compare mComp;
+
+};
+
+/*
+* @brief Rolling minimum and maximum over
+*   the last window samples, kept in a
+*   pair of monotonic queues. Pushing a
+*   sample expires the one that falls
+*   out of the window, so every update
+*   and query is O(1) amortized instead
+*   of a rescan of the window
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+*/
+template<typename Type>
+class SlidingWindow {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty window object
+    *
+    * @param window number of
+    *   samples in the window
+    *
+    * @throw std::invalid_argument
+    *   if the window is empty
+    */
+    explicit SlidingWindow(std::size_t window);
+
+    /*
+    * @brief adds a sample and expires
+    *   the one that falls out of
+    *   the window
+    *
+    * @param sample new sample
+    */
+    void push(const Type& sample);
+
+    /*
+    * @brief adds samples oldest first.
+    *   If the rolling values are needed
+    *   for every sample, they're written
+    *   to the output buffers. Otherwise
+    *   only the samples that end up in
+    *   the window are looked at
+    *
+    * @param samples new samples
+    * @param mins buffer for the minimum
+    *   after every sample or nullptr
+    * @param maxs buffer for the maximum
+    *   after every sample or nullptr
+    */
+    void pushRange(std::span<const Type> samples, Type* mins = nullptr, Type* maxs = nullptr);
+
+    /*
+    * @brief returns the smallest
+    *   sample in the window
+    *
+    * @throw std::runtime_error
+    *   if the window is empty
+    *
+    * @return reference to the
+    *   minimum
+    */
+    const Type& min(void);
+
+    /*
+    * @brief returns the largest
+    *   sample in the window
+    *
+    * @throw std::runtime_error
+    *   if the window is empty
+    *
+    * @return reference to the
+    *   maximum
+    */
+    const Type& max(void);
+
+    /*
+    * @brief returns the number of
+    *   samples in the window
+    *
+    * @return sample count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief checks if the
+    *   window is empty
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+private:
+
+    std::size_t mWindow;
+    MonotonicQueue<Type, std::less<Type>> mMin;
+    MonotonicQueue<Type, std::greater<Type>> mMax;
+
+};
+
+template<typename Type, typename Compare>
+MonotonicQueue<Type, Compare>::MonotonicQueue(Compare comp) :
+    mBegin(0),
+    mEnd(0),
+    mComp(comp)
+{}
+
+template<typename Type, typename Compare>
+void MonotonicQueue<Type, Compare>::push(const Type& value) {
+
+    /*
+     * Ties are dropped as well, the
+     * newer sample stays around longer
+     * and is just as good.
+     */
+    while (!mEntries.isEmpty() && !mComp(mEntries.back().value, value))
+        mEntries.popBack();
+    mEntries.pushBack(Entry{ mEnd++, value });
+}
+
+template<typename Type, typename Compare>
+void MonotonicQueue<Type, Compare>::pushRange(std::span<const Type> values) {
+    for (const Type& value : values)
+        this->push(value);
+}
+
+template<typename Type, typename Compare>
+void MonotonicQueue<Type, Compare>::pop(void) {
+    if (mBegin == mEnd)
+        throw std::runtime_error("Tried to pop from an empty monotonic queue");
+    this->popExpired(mBegin + 1);
+}
+
+template<typename Type, typename Compare>
+void MonotonicQueue<Type, Compare>::popExpired(std::uint64_t position) {
+    if (position > mEnd) { position = mEnd; }
+    if (position <= mBegin) { return; }
+    mBegin = position;
+    while (!mEntries.isEmpty() && mEntries.front().position < position)
+        mEntries.popFront();
+}
+
+template<typename Type, typename Compare>
+const Type& MonotonicQueue<Type, Compare>::top(void) {
+    if (mEntries.isEmpty())
+        throw std::runtime_error("Tried to fetch the top of an empty monotonic queue");
+    return mEntries.front().value;
+}
+
+template<typename Type, typename Compare>
+std::uint64_t MonotonicQueue<Type, Compare>::position(void) {
+    return mEnd;
+}
+
+template<typename Type, typename Compare>
+void MonotonicQueue<Type, Compare>::skip(std::uint64_t count) {
+    mBegin = mEnd = mEnd + count;
+}
+
+template<typename Type, typename Compare>
+void MonotonicQueue<Type, Compare>::clear(void) {
+    mEntries.clear();
+    mBegin = mEnd;
+}
+
+template<typename Type, typename Compare>
+bool MonotonicQueue<Type, Compare>::isEmpty(void) {
+    return mBegin == mEnd;
+}
+
+template<typename Type, typename Compare>
+std::size_t MonotonicQueue<Type, Compare>::size(void) {
+    return static_cast<std::size_t>(mEnd - mBegin);
+}
+
+template<typename Type>
+SlidingWindow<Type>::SlidingWindow(std::size_t window) : mWindow(window) {
+    if (!window)
+        throw std::invalid_argument("Sliding window has to hold at least one sample");
+}
+
+template<typename Type>
+void SlidingWindow<Type>::push(const Type& sample) {
+    mMin.push(sample);
+    mMax.push(sample);
+    if (mMin.size() > mWindow) {
+        mMin.pop();
+        mMax.pop();
+    }
+}
+
+template<typename Type>
+void SlidingWindow<Type>::pushRange(std::span<const Type> samples, Type* mins, Type* maxs) {
+    std::size_t count = samples.size();
+
+    /*
+     * Without outputs only the final
+     * window matters. Everything before
+     * it would expire inside this call
+     * anyway, so it's skipped.
+     */
+    if (!mins && !maxs && count >= mWindow) {
+        std::uint64_t skipped = count - mWindow;
+        mMin.clear();
+        mMax.clear();
+        mMin.skip(skipped);
+        mMax.skip(skipped);
+        samples = samples.subspan(skipped);
+    }
+
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+        this->push(samples[i]);
+        if (mins) { mins[i] = mMin.top(); }
+        if (maxs) { maxs[i] = mMax.top(); }
+    }
+}
+
+template<typename Type>
+const Type& SlidingWindow<Type>::min(void) {
+    return mMin.top();
+}
+
+template<typename Type>
+const Type& SlidingWindow<Type>::max(void) {
+    return mMax.top();
+}
+
+template<typename Type>
+std::size_t SlidingWindow<Type>::size(void) {
+    return mMin.size();
+}
+
+template<typename Type>
+bool SlidingWindow<Type>::isEmpty(void) {
+    return mMin.isEmpty();
+}
+
+#endif
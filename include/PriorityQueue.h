@@ -0,0 +1,522 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Heap.h"
+
+/*
+* @brief Priority queue container built
+*   on an implicit Arity-ary heap. The
+*   top is the element that no other
+*   element goes after according to
+*   Compare, so with the default
+*   std::less it's the greatest one
+*   and with std::greater the smallest
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+* @tparam Compare comparator returning
+*   true if the first argument has
+*   a lower priority
+* @tparam Arity number of children of
+*   a heap node. 4 or 8 make the heap
+*   shallower and more cache friendly
+* @tparam Alloc allocator of
+*   the heap array
+*/
+template<typename Type, typename Compare = std::less<Type>, std::size_t Arity = 2,
+        typename Alloc = std::allocator<Type>>
+class PriorityQueue {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty priority queue
+    *
+    * @param comp comparator
+    * @param alloc allocator
+    */
+    explicit PriorityQueue(Compare comp = Compare(), const Alloc& alloc = Alloc());
+
+    /*
+    * @brief initializes a priority queue
+    *   with a range of values, heapifying
+    *   them in O(n)
+    *
+    * @param first iterator to the
+    *   first value of the range
+    * @param last iterator past the
+    *   last value of the range
+    * @param comp comparator
+    * @param alloc allocator
+    */
+    template<typename InputIt>
+    PriorityQueue(InputIt first, InputIt last, Compare comp = Compare(),
+            const Alloc& alloc = Alloc());
+
+    /*
+    * @brief adds a value to the
+    *   queue in O(log n)
+    *
+    * @param data value to be
+    *   added to the queue
+    */
+    void push(const Type& data);
+    void push(Type&& data);
+
+    /*
+    * @brief constructs a value in
+    *   place and adds it to the
+    *   queue in O(log n)
+    *
+    * @param args arguments passed
+    *   to the constructor of the value
+    */
+    template<typename... Args>
+    void emplace(Args&&... args);
+
+    /*
+    * @brief removes the top value
+    *   from the queue in O(log n)
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return the top value
+    */
+    Type pop(void);
+
+    /*
+    * @brief returns the top value
+    *   without removing it
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return reference to the
+    *   top value
+    */
+    const Type& top(void);
+
+    /*
+    * @brief checks if the
+    *   queue is empty
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number
+    *   of values in the queue
+    *
+    * @return value count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief makes room for the given
+    *   number of values
+    *
+    * @param capacity number of values
+    */
+    void reserve(std::size_t capacity);
+
+private:
+
+    std::vector<Type, Alloc> mHeap;
+    Compare mComp;
+
+};
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+PriorityQueue<Type, Compare, Arity, Alloc>::PriorityQueue(Compare comp, const Alloc& alloc) :
+    mHeap(alloc),
+    mComp(comp)
+{}
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+template<typename InputIt>
+PriorityQueue<Type, Compare, Arity, Alloc>::PriorityQueue(InputIt first, InputIt last,
+        Compare comp, const Alloc& alloc) :
+    mHeap(first, last, alloc),
+    mComp(comp)
+{
+    heap_make<Arity>(mHeap.data(), mHeap.size(), mComp);
+}
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+void PriorityQueue<Type, Compare, Arity, Alloc>::push(const Type& data) {
+    this->emplace(data);
+}
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+void PriorityQueue<Type, Compare, Arity, Alloc>::push(Type&& data) {
+    this->emplace(std::move(data));
+}
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+template<typename... Args>
+void PriorityQueue<Type, Compare, Arity, Alloc>::emplace(Args&&... args) {
+    mHeap.emplace_back(std::forward<Args>(args)...);
+    heap_sift_up<Arity>(mHeap.data(), mHeap.size() - 1, mComp);
+}
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+Type PriorityQueue<Type, Compare, Arity, Alloc>::pop(void) {
+    if (mHeap.empty())
+        throw std::runtime_error("Tried to pop from an empty priority queue");
+
+    /*
+     * Move the last value in place of
+     * the top and sift it down.
+     */
+    Type data = std::move(mHeap.front());
+    if (mHeap.size() > 1) { mHeap.front() = std::move(mHeap.back()); }
+    mHeap.pop_back();
+    heap_sift_down<Arity>(mHeap.data(), mHeap.size(), 0, mComp);
+    return data;
+}
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+const Type& PriorityQueue<Type, Compare, Arity, Alloc>::top(void) {
+    if (mHeap.empty())
+        throw std::runtime_error("Tried to fetch the top of an empty priority queue");
+    return mHeap.front();
+}
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+bool PriorityQueue<Type, Compare, Arity, Alloc>::isEmpty(void) { return mHeap.empty(); }
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+std::size_t PriorityQueue<Type, Compare, Arity, Alloc>::size(void) { return mHeap.size(); }
+
+template<typename Type, typename Compare, std::size_t Arity, typename Alloc>
+void PriorityQueue<Type, Compare, Arity, Alloc>::reserve(std::size_t capacity) { mHeap.reserve(capacity); }
+
+/*
+* @brief Priority queue of values
+*   identified by indexes from
+*   [0, capacity). A position map from
+*   each index to its place in the heap
+*   allows changing or removing the
+*   value of any index in O(log n),
+*   e.g. for Dijkstra's algorithm
+*   with std::greater
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+* @tparam Compare comparator returning
+*   true if the first argument has
+*   a lower priority
+* @tparam Arity number of children
+*   of a heap node
+*/
+template<typename Type, typename Compare = std::less<Type>, std::size_t Arity = 2>
+class IndexedPriorityQueue {
+public:
+
+    /*
+    * @brief initializes an empty
+    *   priority queue
+    *
+    * @param capacity number of
+    *   valid indexes
+    * @param comp comparator
+    */
+    explicit IndexedPriorityQueue(std::size_t capacity, Compare comp = Compare());
+
+    /*
+    * @brief adds a value for
+    *   an index in O(log n)
+    *
+    * @throw std::runtime_error if the
+    *   index is out of range or
+    *   already in the queue
+    *
+    * @param index index of the value
+    * @param data value to be added
+    */
+    void push(std::size_t index, Type data);
+
+    /*
+    * @brief removes the top value
+    *   in O(log n)
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return index of the top value
+    */
+    std::size_t pop(void);
+
+    /*
+    * @brief returns the top value
+    *   without removing it
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return reference to the
+    *   top value
+    */
+    const Type& top(void);
+
+    /*
+    * @brief returns the index of
+    *   the top value
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return index of the top value
+    */
+    std::size_t topIndex(void);
+
+    /*
+    * @brief changes the value of an
+    *   index to one of a higher priority
+    *   and moves it up the heap. With
+    *   std::greater that's a smaller value
+    *
+    * @throw std::runtime_error if
+    *   the index isn't in the queue or
+    *   the new value has a lower priority,
+    *   use update for that
+    *
+    * @param index index of the value
+    * @param data the new value
+    */
+    void decreaseKey(std::size_t index, Type data);
+
+    /*
+    * @brief changes the value of an
+    *   index in either direction
+    *
+    * @throw std::runtime_error if
+    *   the index isn't in the queue
+    *
+    * @param index index of the value
+    * @param data the new value
+    */
+    void update(std::size_t index, Type data);
+
+    /*
+    * @brief removes the value of
+    *   an index in O(log n). Does
+    *   nothing if it isn't there
+    *
+    * @param index index of the value
+    */
+    void erase(std::size_t index);
+
+    /*
+    * @brief checks if an index
+    *   is in the queue
+    *
+    * @param index index to be
+    *   checked
+    *
+    * @return true if present
+    */
+    bool contains(std::size_t index);
+
+    /*
+    * @brief returns the value
+    *   of an index
+    *
+    * @throw std::runtime_error if
+    *   the index isn't in the queue
+    *
+    * @param index index of the value
+    *
+    * @return reference to the value
+    */
+    const Type& valueOf(std::size_t index);
+
+    /*
+    * @brief checks if the
+    *   queue is empty
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number
+    *   of values in the queue
+    *
+    * @return value count
+    */
+    std::size_t size(void);
+
+private:
+
+    static constexpr std::size_t ABSENT = static_cast<std::size_t>(-1);
+
+    /*
+    * @brief compares heap entries
+    *   by the values of their indexes
+    */
+    struct IndexCompare {
+        const IndexedPriorityQueue* queue;
+        bool operator()(std::size_t a, std::size_t b) const {
+            return queue->mComp(queue->mValues[a], queue->mValues[b]);
+        }
+    };
+
+    /*
+    * @brief swaps heap entries and
+    *   updates their positions
+    */
+    struct IndexSwap {
+        IndexedPriorityQueue* queue;
+        void operator()(std::size_t* heap, std::size_t a, std::size_t b) const {
+            std::swap(heap[a], heap[b]);
+            queue->mPositions[heap[a]] = a;
+            queue->mPositions[heap[b]] = b;
+        }
+    };
+
+    /*
+    * @brief removes the heap
+    *   entry at a position
+    */
+    void __remove_at__(std::size_t pos);
+
+    /*
+    * @brief throws if the index
+    *   isn't in the queue
+    */
+    void __check__(std::size_t index);
+
+    std::vector<std::size_t> mHeap;
+    std::vector<std::size_t> mPositions;
+    std::vector<Type> mValues;
+    Compare mComp;
+
+};
+
+template<typename Type, typename Compare, std::size_t Arity>
+IndexedPriorityQueue<Type, Compare, Arity>::IndexedPriorityQueue(std::size_t capacity, Compare comp) :
+    mPositions(capacity, ABSENT),
+    mValues(capacity),
+    mComp(comp)
+{
+    mHeap.reserve(capacity);
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+void IndexedPriorityQueue<Type, Compare, Arity>::push(std::size_t index, Type data) {
+    if (index >= mPositions.size())
+        throw std::runtime_error("Index out of the priority queue's range");
+    if (mPositions[index] != ABSENT)
+        throw std::runtime_error("Index is already in the priority queue");
+
+    mValues[index] = std::move(data);
+    mPositions[index] = mHeap.size();
+    mHeap.push_back(index);
+    heap_sift_up<Arity>(mHeap.data(), mHeap.size() - 1, IndexCompare{ this }, IndexSwap{ this });
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+std::size_t IndexedPriorityQueue<Type, Compare, Arity>::pop(void) {
+    if (mHeap.empty())
+        throw std::runtime_error("Tried to pop from an empty priority queue");
+    std::size_t index = mHeap.front();
+    this->__remove_at__(0);
+    return index;
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+const Type& IndexedPriorityQueue<Type, Compare, Arity>::top(void) {
+    return mValues[this->topIndex()];
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+std::size_t IndexedPriorityQueue<Type, Compare, Arity>::topIndex(void) {
+    if (mHeap.empty())
+        throw std::runtime_error("Tried to fetch the top of an empty priority queue");
+    return mHeap.front();
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+void IndexedPriorityQueue<Type, Compare, Arity>::decreaseKey(std::size_t index, Type data) {
+    this->__check__(index);
+    if (mComp(data, mValues[index]))
+        throw std::runtime_error("Tried to decrease a key to a value of lower priority");
+    mValues[index] = std::move(data);
+    heap_sift_up<Arity>(mHeap.data(), mPositions[index], IndexCompare{ this }, IndexSwap{ this });
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+void IndexedPriorityQueue<Type, Compare, Arity>::update(std::size_t index, Type data) {
+    this->__check__(index);
+    mValues[index] = std::move(data);
+    heap_sift_up<Arity>(mHeap.data(), mPositions[index], IndexCompare{ this }, IndexSwap{ this });
+    heap_sift_down<Arity>(mHeap.data(), mHeap.size(), mPositions[index],
+            IndexCompare{ this }, IndexSwap{ this });
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+void IndexedPriorityQueue<Type, Compare, Arity>::erase(std::size_t index) {
+    if (!this->contains(index)) { return; }
+    this->__remove_at__(mPositions[index]);
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+bool IndexedPriorityQueue<Type, Compare, Arity>::contains(std::size_t index) {
+    return index < mPositions.size() && mPositions[index] != ABSENT;
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+const Type& IndexedPriorityQueue<Type, Compare, Arity>::valueOf(std::size_t index) {
+    this->__check__(index);
+    return mValues[index];
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+bool IndexedPriorityQueue<Type, Compare, Arity>::isEmpty(void) { return mHeap.empty(); }
+
+template<typename Type, typename Compare, std::size_t Arity>
+std::size_t IndexedPriorityQueue<Type, Compare, Arity>::size(void) { return mHeap.size(); }
+
+template<typename Type, typename Compare, std::size_t Arity>
+void IndexedPriorityQueue<Type, Compare, Arity>::__remove_at__(std::size_t pos) {
+
+    /*
+     * Move the last entry into the
+     * hole. It may have to go either
+     * way, as it comes from another
+     * branch of the heap.
+     */
+    IndexSwap swap{ this };
+    std::size_t last = mHeap.size() - 1;
+    if (pos != last) { swap(mHeap.data(), pos, last); }
+
+    mPositions[mHeap.back()] = ABSENT;
+    mHeap.pop_back();
+
+    if (pos < mHeap.size()) {
+        std::size_t moved = mHeap[pos];
+        heap_sift_up<Arity>(mHeap.data(), pos, IndexCompare{ this }, swap);
+        heap_sift_down<Arity>(mHeap.data(), mHeap.size(), mPositions[moved],
+                IndexCompare{ this }, swap);
+    }
+}
+
+template<typename Type, typename Compare, std::size_t Arity>
+void IndexedPriorityQueue<Type, Compare, Arity>::__check__(std::size_t index) {
+    if (!this->contains(index))
+        throw std::runtime_error("Index is not in the priority queue");
+}
+
+#endif
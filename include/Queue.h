@@ -1,80 +1,321 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
 #include <stdexcept>
-#include "ListNode.h"
+#include <type_traits>
+#include <utility>
+
+#include "ExecutionPolicy.h"
 
 /*
 * @brief Generic queue container
-*   that can store any data
-*   type by allocating memory
-*   on the heap
-* 
+*   that stores its values in a
+*   contiguous ring buffer. The buffer
+*   doubles when it fills up, so after
+*   a warm-up enqueue and dequeue don't
+*   allocate at all. It can also be
+*   created with a fixed capacity, in
+*   which case it never allocates after
+*   construction
+*
 * @tparam Type The type parameter
 *   determining the type of data
 *   stored in the container
+* @tparam Alloc allocator of
+*   the ring buffer
 */
-template<typename Type>
+template<typename Type, typename Alloc = std::allocator<Type>>
 class Queue {
 public:
 
+    /*
+    * @brief forward iterator visiting
+    *   the values from front to back.
+    *   Enqueueing can move the buffer,
+    *   which invalidates all iterators
+    *
+    * @tparam Const true if the values
+    *   are read-only through it
+    */
+    template<bool Const>
+    class BasicIterator {
+    public:
+
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const Type*, Type*>;
+        using reference = std::conditional_t<Const, const Type&, Type&>;
+
+        BasicIterator(void) : mBuffer(nullptr), mMask(0), mPos(0) {}
+
+        /*
+        * @brief creates an iterator
+        *   pointing into the ring
+        *
+        * @param buffer ring buffer
+        * @param mask capacity - 1
+        * @param pos position counted
+        *   from the start of the buffer,
+        *   wrapped when dereferenced
+        */
+        BasicIterator(pointer buffer, std::size_t mask, std::size_t pos) :
+            mBuffer(buffer),
+            mMask(mask),
+            mPos(pos)
+        {}
+
+        /*
+        * @brief a mutable iterator
+        *   converts to a const one
+        */
+        template<bool OtherConst> requires (Const && !OtherConst)
+        BasicIterator(const BasicIterator<OtherConst>& other) :
+            mBuffer(other.mBuffer),
+            mMask(other.mMask),
+            mPos(other.mPos)
+        {}
+
+        reference operator*(void) const { return mBuffer[mPos & mMask]; }
+        pointer operator->(void) const { return mBuffer + (mPos & mMask); }
+
+        BasicIterator& operator++(void) {
+            ++mPos;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
+            ++mPos;
+            return tmp;
+        }
+
+        bool operator==(const BasicIterator& other) const { return mPos == other.mPos; }
+
+    private:
+
+        template<bool>
+        friend class BasicIterator;
+
+        pointer mBuffer;
+        std::size_t mMask;
+        std::size_t mPos;
+
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
     /*
     * @brief initializes an
-    *   empty queue object
+    *   empty queue object. No
+    *   memory is allocated until
+    *   the first enqueue
     */
     Queue(void);
 
+    /*
+    * @brief initializes an empty
+    *   queue object that allocates
+    *   its buffer with the given
+    *   allocator
+    *
+    * @param alloc allocator
+    */
+    explicit Queue(const Alloc& alloc);
+
+    /*
+    * @brief initializes an empty
+    *   queue object with preallocated
+    *   storage
+    *
+    * @param capacity initial capacity,
+    *   rounded up to a power of two
+    * @param fixed if true the queue
+    *   never grows beyond the capacity
+    * @param alloc allocator
+    */
+    explicit Queue(std::size_t capacity, bool fixed = false, const Alloc& alloc = Alloc());
+
+    /*
+    * @brief destroys the remaining
+    *   values and frees the buffer
+    */
+    ~Queue(void);
+
+    Queue(const Queue&) = delete;
+    Queue& operator=(const Queue&) = delete;
+
     /*
     * @brief adds a value
     *   at the back of the
     *   queue
-    * 
+    *
+    * @throw std::runtime_error
+    *   if a fixed capacity queue
+    *   is full
+    *
     * @param data value to
     *   be added to the queue
     */
-	void enqueue(Type data);
+	void enqueue(const Type& data);
+	void enqueue(Type&& data);
+
+    /*
+    * @brief constructs a value in
+    *   place at the back of the queue
+    *
+    * @throw std::runtime_error
+    *   if a fixed capacity queue
+    *   is full
+    *
+    * @param args arguments passed
+    *   to the constructor of the value
+    *
+    * @return reference to the
+    *   new value
+    */
+    template<typename... Args>
+    Type& emplace(Args&&... args);
 
     /*
     * @brief returns a value
     *   from the front of the
     *   queue and deletes it
     *   from the queue
-    * 
+    *
     * @throw std::runtime_error
     *   if the queue is empty
-    * 
+    *
     * @return value fetched from
     *   the front of the queue
     */
 	Type dequeue(void);
 
+    /*
+    * @brief adds a value at the
+    *   back of the queue if there's
+    *   room for it
+    *
+    * @param data value to
+    *   be added to the queue
+    *
+    * @return false if a fixed
+    *   capacity queue is full.
+    *   The value is left untouched
+    */
+    bool tryEnqueue(const Type& data);
+    bool tryEnqueue(Type&& data);
+
+    /*
+    * @brief moves the value from the
+    *   front of the queue into out if
+    *   the queue isn't empty
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the
+    *   queue is empty
+    */
+    bool tryDequeue(Type& out);
+
+    /*
+    * @brief adds a range of values at
+    *   the back of the queue. The buffer
+    *   grows at most once and the values
+    *   are copied in at most two passes,
+    *   one on each side of the wrap
+    *
+    * @throw std::runtime_error
+    *   if a fixed capacity queue
+    *   doesn't have room for all of
+    *   them. Nothing is added then
+    *
+    * @param values values to be
+    *   added to the queue
+    */
+    void enqueueRange(std::span<const Type> values);
+
+    /*
+    * @brief moves up to count values
+    *   from the front of the queue
+    *   into a buffer
+    *
+    * @param out buffer for at
+    *   least count values
+    * @param count maximum number
+    *   of values to dequeue
+    *
+    * @return number of values
+    *   dequeued, less than count if
+    *   the queue runs out
+    */
+    std::size_t dequeueN(Type* out, std::size_t count);
+
+    /*
+     * @brief enqueueRange and dequeueN
+     *  with an execution policy. With a
+     *  parallel policy trivially copyable
+     *  values are copied by the pool in
+     *  chunks. Other types and seq fall
+     *  back to the plain versions
+     *
+     * @param policy execution policy
+     */
+    void enqueueRange(ExecutionPolicy policy, std::span<const Type> values);
+    std::size_t dequeueN(ExecutionPolicy policy, Type* out, std::size_t count);
+
+    /*
+    * @brief moves all of the values
+    *   out from front to back and
+    *   leaves the queue empty. The
+    *   buffer is kept
+    *
+    * @param out output iterator
+    *   receiving the values
+    *
+    * @return the output iterator
+    *   past the last value
+    */
+    template<typename OutputIt>
+    OutputIt drainTo(OutputIt out);
+
     /*
     * @brief returns a value
-    *   from the front of the 
+    *   from the front of the
     *   queue without deleting
     *   it from the queue
-    * 
+    *
     * @throw std::runtime_error
     *   if the queue is empty
-    * 
-    * @return value fetched from
-    *   the front of the queue
+    *
+    * @return reference to the
+    *   front of the queue
     */
-	Type first(void);
+	Type& first(void);
 
     /*
     * @brief returns a value
-    *   from the back of the 
+    *   from the back of the
     *   queue without deleting
     *   it from the queue
-    * 
+    *
     * @throw std::runtime_error
     *   if the queue is empty
-    * 
-    * @return value fetched from
-    *   the back of the queue
+    *
+    * @return reference to the
+    *   back of the queue
     */
-	Type last(void);
+	Type& last(void);
 
     /*
      * @brief returns true
@@ -85,52 +326,431 @@ public:
      */
     bool isEmpty(void);
 
+    /*
+     * @brief returns true if a
+     *  fixed capacity queue is
+     *  full. Growable queues are
+     *  never full
+     *
+     * @return true if full,
+     *  false otherwise
+     */
+    bool isFull(void);
+
+    /*
+     * @brief returns the number
+     *  of values in the queue
+     *
+     * @return value count
+     */
+    std::size_t size(void);
+
+    /*
+     * @brief returns the number of
+     *  values that fit in the buffer
+     *
+     * @return buffer capacity
+     */
+    std::size_t capacity(void);
+
+    /*
+     * @brief returns an iterator
+     *  to the front of the queue
+     *
+     * @return iterator to the
+     *  first value
+     */
+    Iterator begin(void);
+    ConstIterator begin(void) const;
+
+    /*
+     * @brief returns an iterator
+     *  past the back of the queue
+     *
+     * @return end iterator
+     */
+    Iterator end(void);
+    ConstIterator end(void) const;
+
 private:
 
-	ListNode<Type>* mHead;
-	ListNode<Type>* mTail;
+    /*
+     * @brief moves the values into
+     *  a buffer of the given capacity
+     */
+    void __reallocate__(std::size_t capacity);
+
+    /*
+     * @brief moves the values to the
+     *  front of a new buffer and frees
+     *  the old one
+     */
+    void __adopt__(Type* buffer, std::size_t capacity);
+
+    /*
+     * @brief returns the slot behind the
+     *  last value, growing the buffer if
+     *  needed
+     *
+     * @return the slot or nullptr if a
+     *  fixed capacity queue is full
+     */
+    Type* __back_slot__(void);
+
+    using Traits = std::allocator_traits<Alloc>;
+
+    Type* mBuffer;
+    std::size_t mCapacity;
+    std::size_t mHead;
+    std::size_t mSize;
+    bool mFixed;
+    [[no_unique_address]] Alloc mAlloc;
 
 };
 
-template<typename Type>
-Queue<Type>::Queue(void) : mHead(nullptr), mTail(nullptr) {}
+template<typename Type, typename Alloc>
+Queue<Type, Alloc>::Queue(void) :
+    mBuffer(nullptr),
+    mCapacity(0),
+    mHead(0),
+    mSize(0),
+    mFixed(false)
+{}
 
-template<typename Type>
-void Queue<Type>::enqueue(Type data) {
-    if (!mHead) {
-        mHead = mTail = new ListNode<Type>(data);
-    } else {
-        mTail->setNext(new ListNode<Type>(data));
-        mTail = mTail->getNext();
+template<typename Type, typename Alloc>
+Queue<Type, Alloc>::Queue(const Alloc& alloc) :
+    mBuffer(nullptr),
+    mCapacity(0),
+    mHead(0),
+    mSize(0),
+    mFixed(false),
+    mAlloc(alloc)
+{}
+
+template<typename Type, typename Alloc>
+Queue<Type, Alloc>::Queue(std::size_t capacity, bool fixed, const Alloc& alloc) : Queue(alloc) {
+    std::size_t rounded = 1;
+    while (rounded < capacity)
+        rounded <<= 1;
+    this->__reallocate__(rounded);
+    mFixed = fixed;
+}
+
+template<typename Type, typename Alloc>
+Queue<Type, Alloc>::~Queue(void) {
+    for (std::size_t i = 0; i < mSize; ++i)
+        mBuffer[(mHead + i) & (mCapacity - 1)].~Type();
+    if (mBuffer) { Traits::deallocate(mAlloc, mBuffer, mCapacity); }
+}
+
+template<typename Type, typename Alloc>
+void Queue<Type, Alloc>::enqueue(const Type& data) {
+    this->emplace(data);
+}
+
+template<typename Type, typename Alloc>
+void Queue<Type, Alloc>::enqueue(Type&& data) {
+    this->emplace(std::move(data));
+}
+
+template<typename Type, typename Alloc>
+template<typename... Args>
+Type& Queue<Type, Alloc>::emplace(Args&&... args) {
+    if (mSize == mCapacity && mCapacity && !mFixed) {
+
+        /*
+         * The arguments may refer to a
+         * value in the queue, so the new
+         * value is built before the old
+         * buffer goes.
+         */
+        Type data(std::forward<Args>(args)...);
+        Type* slot = this->__back_slot__();
+        new (slot) Type(std::move(data));
+        ++mSize;
+        return *slot;
     }
+
+    Type* slot = this->__back_slot__();
+    if (!slot)
+        throw std::runtime_error("Tried to enqueue into a full queue");
+    new (slot) Type(std::forward<Args>(args)...);
+    ++mSize;
+    return *slot;
 }
 
-template<typename Type>
-Type Queue<Type>::dequeue(void) {
-    if (!mHead)
+template<typename Type, typename Alloc>
+Type Queue<Type, Alloc>::dequeue(void) {
+    if (!mSize)
         throw std::runtime_error("Tried to dequeue an empty queue");
-    Type data = mHead->getData();
-    ListNode<Type>* tmp = mHead;
-    mHead = mHead->getNext();
-    delete tmp;
+    Type* slot = mBuffer + mHead;
+    Type data = std::move(*slot);
+    slot->~Type();
+    mHead = (mHead + 1) & (mCapacity - 1);
+    --mSize;
     return data;
 }
 
-template<typename Type>
-Type Queue<Type>::first(void) {
-    if (!mHead)
+template<typename Type, typename Alloc>
+bool Queue<Type, Alloc>::tryEnqueue(const Type& data) {
+    if (mFixed && mSize == mCapacity) { return false; }
+    this->emplace(data);
+    return true;
+}
+
+template<typename Type, typename Alloc>
+bool Queue<Type, Alloc>::tryEnqueue(Type&& data) {
+    if (mFixed && mSize == mCapacity) { return false; }
+    this->emplace(std::move(data));
+    return true;
+}
+
+template<typename Type, typename Alloc>
+bool Queue<Type, Alloc>::tryDequeue(Type& out) {
+    if (!mSize) { return false; }
+    Type* slot = mBuffer + mHead;
+    out = std::move(*slot);
+    slot->~Type();
+    mHead = (mHead + 1) & (mCapacity - 1);
+    --mSize;
+    return true;
+}
+
+template<typename Type, typename Alloc>
+void Queue<Type, Alloc>::enqueueRange(std::span<const Type> values) {
+    std::size_t count = values.size();
+    if (!count) { return; }
+
+    if (mSize + count > mCapacity) {
+        if (mFixed)
+            throw std::runtime_error("Tried to enqueue more values than a full queue can take");
+
+        /*
+         * The values may come from the queue
+         * itself, so they're copied into the
+         * new buffer before the old one goes.
+         */
+        std::size_t capacity = mCapacity ? mCapacity : 16;
+        while (capacity < mSize + count)
+            capacity <<= 1;
+
+        Type* buffer = Traits::allocate(mAlloc, capacity);
+        try {
+            std::uninitialized_copy(values.begin(), values.end(), buffer + mSize);
+        } catch (...) {
+            Traits::deallocate(mAlloc, buffer, capacity);
+            throw;
+        }
+        this->__adopt__(buffer, capacity);
+        mSize += count;
+        return;
+    }
+
+    /*
+     * The free slots behind the back may
+     * wrap around the end of the buffer.
+     * The size is bumped after the first
+     * part, so a throwing copy leaves a
+     * consistent queue behind.
+     */
+    std::size_t back = (mHead + mSize) & (mCapacity - 1);
+    std::size_t tail = std::min(count, mCapacity - back);
+    std::uninitialized_copy(values.begin(), values.begin() + tail, mBuffer + back);
+    mSize += tail;
+    std::uninitialized_copy(values.begin() + tail, values.end(), mBuffer);
+    mSize += count - tail;
+}
+
+template<typename Type, typename Alloc>
+std::size_t Queue<Type, Alloc>::dequeueN(Type* out, std::size_t count) {
+    count = std::min(count, mSize);
+    std::size_t tail = std::min(count, mCapacity - mHead);
+
+    Type* front = mBuffer + mHead;
+    std::move(front, front + tail, out);
+    std::destroy(front, front + tail);
+    std::move(mBuffer, mBuffer + (count - tail), out + tail);
+    std::destroy(mBuffer, mBuffer + (count - tail));
+
+    if (count) { mHead = (mHead + count) & (mCapacity - 1); }
+    mSize -= count;
+    return count;
+}
+
+template<typename Type, typename Alloc>
+void Queue<Type, Alloc>::enqueueRange(ExecutionPolicy policy, std::span<const Type> values) {
+    if constexpr (!std::is_trivially_copyable_v<Type>) {
+        this->enqueueRange(values);
+    } else {
+        if (policy == ExecutionPolicy::seq) {
+            this->enqueueRange(values);
+            return;
+        }
+
+        std::size_t count = values.size();
+        if (!count) { return; }
+
+        if (mSize + count > mCapacity) {
+            if (mFixed)
+                throw std::runtime_error("Tried to enqueue more values than a full queue can take");
+
+            std::size_t capacity = mCapacity ? mCapacity : 16;
+            while (capacity < mSize + count)
+                capacity <<= 1;
+
+            /*
+             * The new values go in first, they
+             * may come from the queue itself.
+             * Then both sides of the old ring
+             * are copied to the front.
+             */
+            Type* buffer = Traits::allocate(mAlloc, capacity);
+            try {
+                std::size_t tail = std::min(mSize, mCapacity - mHead);
+                parallel_copy(policy, values.data(), count, buffer + mSize);
+                parallel_copy(policy, static_cast<const Type*>(mBuffer + mHead), tail, buffer);
+                parallel_copy(policy, static_cast<const Type*>(mBuffer), mSize - tail, buffer + tail);
+            } catch (...) {
+                Traits::deallocate(mAlloc, buffer, capacity);
+                throw;
+            }
+
+            if (mBuffer) { Traits::deallocate(mAlloc, mBuffer, mCapacity); }
+            mBuffer = buffer;
+            mCapacity = capacity;
+            mHead = 0;
+            mSize += count;
+            return;
+        }
+
+        std::size_t back = (mHead + mSize) & (mCapacity - 1);
+        std::size_t tail = std::min(count, mCapacity - back);
+        parallel_copy(policy, values.data(), tail, mBuffer + back);
+        parallel_copy(policy, values.data() + tail, count - tail, mBuffer);
+        mSize += count;
+    }
+}
+
+template<typename Type, typename Alloc>
+std::size_t Queue<Type, Alloc>::dequeueN(ExecutionPolicy policy, Type* out, std::size_t count) {
+    if constexpr (!std::is_trivially_copyable_v<Type>) {
+        return this->dequeueN(out, count);
+    } else {
+        if (policy == ExecutionPolicy::seq) { return this->dequeueN(out, count); }
+
+        count = std::min(count, mSize);
+        std::size_t tail = std::min(count, mCapacity - mHead);
+        parallel_copy(policy, static_cast<const Type*>(mBuffer + mHead), tail, out);
+        parallel_copy(policy, static_cast<const Type*>(mBuffer), count - tail, out + tail);
+
+        if (count) { mHead = (mHead + count) & (mCapacity - 1); }
+        mSize -= count;
+        return count;
+    }
+}
+
+template<typename Type, typename Alloc>
+template<typename OutputIt>
+OutputIt Queue<Type, Alloc>::drainTo(OutputIt out) {
+    std::size_t tail = std::min(mSize, mCapacity - mHead);
+
+    Type* front = mBuffer + mHead;
+    out = std::move(front, front + tail, out);
+    std::destroy(front, front + tail);
+    out = std::move(mBuffer, mBuffer + (mSize - tail), out);
+    std::destroy(mBuffer, mBuffer + (mSize - tail));
+
+    mHead = 0;
+    mSize = 0;
+    return out;
+}
+
+template<typename Type, typename Alloc>
+Type& Queue<Type, Alloc>::first(void) {
+    if (!mSize)
         throw std::runtime_error("Tired to fetch the first element of an empty queue");
-    return mHead->getData();
+    return mBuffer[mHead];
 }
 
-template<typename Type>
-Type Queue<Type>::last(void) {
-    if (!mHead)
+template<typename Type, typename Alloc>
+Type& Queue<Type, Alloc>::last(void) {
+    if (!mSize)
         throw std::runtime_error("Tired to fetch the last element of an empty queue");
-    return mTail->getData();
+    return mBuffer[(mHead + mSize - 1) & (mCapacity - 1)];
 }
 
-template<typename Type>
-bool Queue<Type>::isEmpty(void) { return mHead ? false : true; } 
+template<typename Type, typename Alloc>
+bool Queue<Type, Alloc>::isEmpty(void) { return mSize ? false : true; }
+
+template<typename Type, typename Alloc>
+bool Queue<Type, Alloc>::isFull(void) { return mFixed && mSize == mCapacity; }
+
+template<typename Type, typename Alloc>
+std::size_t Queue<Type, Alloc>::size(void) { return mSize; }
+
+template<typename Type, typename Alloc>
+std::size_t Queue<Type, Alloc>::capacity(void) { return mCapacity; }
+
+template<typename Type, typename Alloc>
+typename Queue<Type, Alloc>::Iterator Queue<Type, Alloc>::begin(void) {
+    return Iterator(mBuffer, mCapacity - 1, mHead);
+}
+
+template<typename Type, typename Alloc>
+typename Queue<Type, Alloc>::Iterator Queue<Type, Alloc>::end(void) {
+    return Iterator(mBuffer, mCapacity - 1, mHead + mSize);
+}
+
+template<typename Type, typename Alloc>
+typename Queue<Type, Alloc>::ConstIterator Queue<Type, Alloc>::begin(void) const {
+    return ConstIterator(mBuffer, mCapacity - 1, mHead);
+}
+
+template<typename Type, typename Alloc>
+typename Queue<Type, Alloc>::ConstIterator Queue<Type, Alloc>::end(void) const {
+    return ConstIterator(mBuffer, mCapacity - 1, mHead + mSize);
+}
+
+template<typename Type, typename Alloc>
+void Queue<Type, Alloc>::__reallocate__(std::size_t capacity) {
+    this->__adopt__(Traits::allocate(mAlloc, capacity), capacity);
+}
+
+template<typename Type, typename Alloc>
+void Queue<Type, Alloc>::__adopt__(Type* buffer, std::size_t capacity) {
+
+    /*
+     * Move the values over in order,
+     * so the front of the queue ends
+     * up at the start of the new buffer.
+     */
+    for (std::size_t i = 0; i < mSize; ++i) {
+        Type* slot = mBuffer + ((mHead + i) & (mCapacity - 1));
+        new (buffer + i) Type(std::move(*slot));
+        slot->~Type();
+    }
+
+    if (mBuffer) { Traits::deallocate(mAlloc, mBuffer, mCapacity); }
+    mBuffer = buffer;
+    mCapacity = capacity;
+    mHead = 0;
+}
+
+template<typename Type, typename Alloc>
+Type* Queue<Type, Alloc>::__back_slot__(void) {
+    if (mSize == mCapacity) {
+        if (mFixed) { return nullptr; }
+        this->__reallocate__(mCapacity ? mCapacity * 2 : 16);
+    }
+    return mBuffer + ((mHead + mSize) & (mCapacity - 1));
+}
+
+/*
+ * Read-only code gets the same
+ * ranges support through the
+ * const overloads.
+ */
+static_assert(std::ranges::forward_range<Queue<int>>);
+static_assert(std::ranges::forward_range<const Queue<int>>);
 
 #endif
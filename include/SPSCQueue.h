@@ -0,0 +1,249 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+/*
+* @brief Bounded wait-free queue for
+*   exactly one producer thread and
+*   exactly one consumer thread.
+*
+*   The head index is written only by
+*   the consumer and the tail index only
+*   by the producer, each on its own cache
+*   line. Both sides also keep a private
+*   copy of the other side's index and
+*   only reload it when the copy says the
+*   queue is full or empty, so in the
+*   steady state the threads don't touch
+*   each other's cache lines
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+*/
+template<typename Type>
+class SPSCQueue {
+public:
+
+    /*
+    * @brief initializes an
+    *   empty queue object
+    *
+    * @param capacity capacity of
+    *   the queue, rounded up to
+    *   a power of two
+    */
+    explicit SPSCQueue(std::size_t capacity);
+
+    /*
+    * @brief destroys the remaining
+    *   values and frees the buffer
+    */
+    ~SPSCQueue(void);
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /*
+    * @brief adds a value at the
+    *   back of the queue. Producer
+    *   only
+    *
+    * @param data value to be
+    *   added to the queue
+    *
+    * @return false if the
+    *   queue is full
+    */
+    bool tryEnqueue(Type data);
+
+    /*
+    * @brief moves the value from the
+    *   front of the queue into out.
+    *   Consumer only
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the
+    *   queue is empty
+    */
+    bool tryDequeue(Type& out);
+
+    /*
+    * @brief adds as many values from
+    *   the array as there's room for,
+    *   publishing all of them at once.
+    *   Producer only
+    *
+    * @param data array of values
+    * @param count length of the array
+    *
+    * @return number of values
+    *   added to the queue
+    */
+    std::size_t enqueueBatch(const Type* data, std::size_t count);
+
+    /*
+    * @brief moves up to max values from
+    *   the front of the queue into the
+    *   array, releasing their slots at
+    *   once. Consumer only
+    *
+    * @param out destination array
+    * @param max length of the array
+    *
+    * @return number of values
+    *   moved into the array
+    */
+    std::size_t dequeueBatch(Type* out, std::size_t max);
+
+    /*
+    * @brief checks if the queue is
+    *   empty. Exact only when called
+    *   by the consumer
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the capacity
+    *   of the queue
+    *
+    * @return capacity
+    */
+    std::size_t capacity(void);
+
+private:
+
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    /*
+     * Consumer side
+     */
+    alignas(CACHE_LINE) std::atomic<std::size_t> mHead;
+    std::size_t mCachedTail;
+
+    /*
+     * Producer side
+     */
+    alignas(CACHE_LINE) std::atomic<std::size_t> mTail;
+    std::size_t mCachedHead;
+
+    /*
+     * Shared, read-only
+     */
+    alignas(CACHE_LINE) Type* mBuffer;
+    std::size_t mMask;
+
+};
+
+template<typename Type>
+SPSCQueue<Type>::SPSCQueue(std::size_t capacity) :
+    mHead(0),
+    mCachedTail(0),
+    mTail(0),
+    mCachedHead(0)
+{
+    std::size_t rounded = 1;
+    while (rounded < capacity)
+        rounded <<= 1;
+    mBuffer = std::allocator<Type>().allocate(rounded);
+    mMask = rounded - 1;
+}
+
+template<typename Type>
+SPSCQueue<Type>::~SPSCQueue(void) {
+    std::size_t tail = mTail.load(std::memory_order_relaxed);
+    for (std::size_t i = mHead.load(std::memory_order_relaxed); i != tail; ++i)
+        mBuffer[i & mMask].~Type();
+    std::allocator<Type>().deallocate(mBuffer, mMask + 1);
+}
+
+template<typename Type>
+bool SPSCQueue<Type>::tryEnqueue(Type data) {
+    std::size_t tail = mTail.load(std::memory_order_relaxed);
+
+    /*
+     * Only look at the consumer's
+     * index when the cached copy
+     * says the queue is full.
+     */
+    if (tail - mCachedHead > mMask) {
+        mCachedHead = mHead.load(std::memory_order_acquire);
+        if (tail - mCachedHead > mMask) { return false; }
+    }
+
+    new (mBuffer + (tail & mMask)) Type(std::move(data));
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename Type>
+bool SPSCQueue<Type>::tryDequeue(Type& out) {
+    std::size_t head = mHead.load(std::memory_order_relaxed);
+
+    if (head == mCachedTail) {
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        if (head == mCachedTail) { return false; }
+    }
+
+    Type* slot = mBuffer + (head & mMask);
+    out = std::move(*slot);
+    slot->~Type();
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename Type>
+std::size_t SPSCQueue<Type>::enqueueBatch(const Type* data, std::size_t count) {
+    std::size_t tail = mTail.load(std::memory_order_relaxed);
+    std::size_t free = mMask + 1 - (tail - mCachedHead);
+    if (free < count) {
+        mCachedHead = mHead.load(std::memory_order_acquire);
+        free = mMask + 1 - (tail - mCachedHead);
+    }
+    if (count > free) { count = free; }
+
+    for (std::size_t i = 0; i < count; ++i)
+        new (mBuffer + ((tail + i) & mMask)) Type(data[i]);
+    mTail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+template<typename Type>
+std::size_t SPSCQueue<Type>::dequeueBatch(Type* out, std::size_t max) {
+    std::size_t head = mHead.load(std::memory_order_relaxed);
+    std::size_t available = mCachedTail - head;
+    if (available < max) {
+        mCachedTail = mTail.load(std::memory_order_acquire);
+        available = mCachedTail - head;
+    }
+    if (max > available) { max = available; }
+
+    for (std::size_t i = 0; i < max; ++i) {
+        Type* slot = mBuffer + ((head + i) & mMask);
+        out[i] = std::move(*slot);
+        slot->~Type();
+    }
+    mHead.store(head + max, std::memory_order_release);
+    return max;
+}
+
+template<typename Type>
+bool SPSCQueue<Type>::isEmpty(void) {
+    return mHead.load(std::memory_order_acquire) == mTail.load(std::memory_order_acquire);
+}
+
+template<typename Type>
+std::size_t SPSCQueue<Type>::capacity(void) {
+    return mMask + 1;
+}
+
+#endif
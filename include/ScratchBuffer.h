@@ -0,0 +1,101 @@
+#ifndef SCRATCH_BUFFER_H
+#define SCRATCH_BUFFER_H
+
+#include <cstddef>
+
+/*
+* @brief Temporary memory for the
+*   sorting algorithms. Released
+*   buffers are cached per thread and
+*   handed out again by the next
+*   request that fits, so repeated
+*   sorts don't pay for the allocation
+*   and the first-touch page faults
+*   every time.
+*
+*   Large buffers are mapped straight
+*   from the kernel, backed with huge
+*   pages and pre-faulted, depending on
+*   the configuration.
+*
+*   A pool worker caches at most 64 MiB
+*   by default, larger buffers are freed
+*   right away. Other threads keep up to
+*   four buffers of any size until
+*   releaseCached is called.
+*/
+class ScratchBuffer {
+public:
+
+    /*
+    * @brief acquires a buffer of at
+    *   least the given size. The
+    *   contents are uninitialised
+    *
+    * @param bytes requested size
+    *
+    * @throw std::bad_alloc if the
+    *   memory can't be allocated
+    */
+    explicit ScratchBuffer(std::size_t bytes);
+
+    /*
+    * @brief returns the buffer
+    *   to the thread's cache
+    */
+    ~ScratchBuffer(void);
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    /*
+    * @brief returns the buffer
+    *   as an array
+    *
+    * @tparam Type element type
+    *   of the array
+    *
+    * @return pointer to the
+    *   first element
+    */
+    template<typename Type>
+    Type* as(void) { return static_cast<Type*>(mData); }
+
+    /*
+    * @brief configures how the large
+    *   buffers are mapped. Affects only
+    *   the buffers allocated afterwards
+    *
+    * @param hugePages back the buffers
+    *   with transparent huge pages
+    * @param populate pre-fault the pages
+    *   when the buffer is mapped
+    */
+    static void configure(bool hugePages, bool populate);
+
+    /*
+    * @brief sets the number of bytes a
+    *   pool worker may keep cached.
+    *   Buffers over the limit aren't
+    *   cached. Affects only the buffers
+    *   released afterwards
+    *
+    * @param bytes per worker limit,
+    *   0 disables the workers' caches
+    */
+    static void setCacheLimit(std::size_t bytes);
+
+    /*
+    * @brief frees all of the buffers
+    *   cached by the calling thread
+    */
+    static void releaseCached(void);
+
+private:
+
+    void* mData;
+    std::size_t mCapacity;
+
+};
+
+#endif
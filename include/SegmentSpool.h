@@ -0,0 +1,103 @@
+#ifndef SEGMENT_SPOOL_H
+#define SEGMENT_SPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MappedFile.h"
+
+/*
+* @brief FIFO of segment files in a
+*   directory. Every segment is written
+*   once, front to back, into a file of
+*   its own and read back through a
+*   read-only mapping. The files are
+*   never rewritten, so the disk only
+*   sees sequential writes. Reading a
+*   segment starts the readahead of the
+*   next one, so a replay doesn't stall
+*   at every segment boundary.
+*
+*   The files are scratch space, they
+*   aren't synced and don't survive
+*   the spool
+*/
+class SegmentSpool {
+public:
+
+    /*
+    * @brief creates an empty spool
+    *
+    * @param directory existing directory
+    *   the segment files go to
+    */
+    explicit SegmentSpool(const std::string& directory);
+
+    /*
+    * @brief removes the segment
+    *   files that weren't read
+    */
+    ~SegmentSpool(void);
+
+    SegmentSpool(const SegmentSpool&) = delete;
+    SegmentSpool& operator=(const SegmentSpool&) = delete;
+
+    /*
+    * @brief writes a segment at
+    *   the back of the spool
+    *
+    * @param data bytes of the segment
+    * @param size number of bytes
+    *
+    * @throw std::runtime_error if the
+    *   file can't be written
+    */
+    void append(const void* data, std::size_t size);
+
+    /*
+    * @brief maps the segment at the front
+    *   of the spool and takes it off the
+    *   spool. The file is unlinked right
+    *   away, the mapping keeps it alive
+    *   until it's deleted. The spool must
+    *   not be empty
+    *
+    * @throw std::runtime_error if the
+    *   file can't be mapped
+    *
+    * @return mapping of the segment,
+    *   owned by the caller
+    */
+    MappedFile* next(void);
+
+    /*
+    * @brief returns the number
+    *   of segments on disk
+    *
+    * @return segment count
+    */
+    std::size_t count(void) const;
+
+private:
+
+    /*
+    * @brief maps a segment file
+    *   and asks for readahead
+    */
+    MappedFile* __map__(std::uint64_t segment);
+
+    /*
+    * @brief returns the path
+    *   of a segment file
+    */
+    std::string __path__(std::uint64_t segment) const;
+
+    std::string mPrefix;
+    std::uint64_t mFirst;
+    std::uint64_t mEnd;
+    MappedFile* mPrefetched;
+
+};
+
+#endif
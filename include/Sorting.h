@@ -1,10 +1,83 @@
 #ifndef SORTING_H
 #define SORTING_H
 
+#include "Stack.h"
+#include "ThreadPool.h"
+
 void merge_sort(int* arr, const int& lptr, const int& rptr);
 void quick_sort(int* arr, const int& lptr, const int& rptr);
 void heap_sort(int* arr, const int& arrSize);
 void counting_sort(int* arr, const int& arrSize);
 void radix_sort(int* arr, const int& arrSize);
 
+/*
+ * Execution policy overloads. With 
+ * ExecutionPolicy::seq they are the 
+ * same as the plain versions, with the 
+ * parallel policies the work is split 
+ * across the global ThreadPool. heap_sort 
+ * has no independent work and always runs 
+ * on the calling thread.
+ */
+void merge_sort(ExecutionPolicy policy, int* arr, const int& lptr, const int& rptr);
+void quick_sort(ExecutionPolicy policy, int* arr, const int& lptr, const int& rptr);
+void heap_sort(ExecutionPolicy policy, int* arr, const int& arrSize);
+void counting_sort(ExecutionPolicy policy, int* arr, const int& arrSize);
+void radix_sort(ExecutionPolicy policy, int* arr, const int& arrSize);
+
+/*
+* @brief Lazy sort that yields the 
+*   values of an array in ascending 
+*   order on demand. It uses incremental 
+*   quicksort, so fetching the first k 
+*   values costs O(n + k log k) on 
+*   average and the rest of the array 
+*   is never sorted if it's not needed.
+*   The array is reordered in place.
+*/
+class IncrementalSort {
+public:
+
+    /*
+    * @brief prepares the array for 
+    *   incremental sorting. No sorting 
+    *   work is done until the first 
+    *   call to next
+    * 
+    * @param arr array to be sorted
+    * @param arrSize length of the array
+    */
+    IncrementalSort(int* arr, const int& arrSize);
+
+    /*
+    * @brief checks if there are 
+    *   any values left to fetch
+    * 
+    * @return true if next can 
+    *   be called
+    */
+    bool hasNext(void);
+
+    /*
+    * @brief returns the next smallest 
+    *   value. After k calls the first k 
+    *   elements of the array are sorted
+    * 
+    * @throw std::runtime_error
+    *   if all values were fetched
+    * 
+    * @return next value in 
+    *   ascending order
+    */
+    int next(void);
+
+private:
+
+    int* mArr;
+    int mSize;
+    int mIdx;
+    Stack<int> mPivots;
+
+};
+
 #endif
@@ -0,0 +1,376 @@
+#ifndef SPILL_QUEUE_H
+#define SPILL_QUEUE_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "MappedFile.h"
+#include "Queue.h"
+#include "SegmentSpool.h"
+
+/*
+* @brief Queue that spills to disk once
+*   its backlog outgrows a memory budget.
+*   The values are kept in fixed size
+*   segments. The head segment being
+*   dequeued from and the tail segment
+*   being enqueued into always stay in
+*   memory. Full segments between them
+*   stay in memory while the budget
+*   allows it, after that they're written
+*   to segment files and read back
+*   through memory mappings when the
+*   head reaches them.
+*
+*   Once a segment is on disk, all of the
+*   segments behind it go to disk as well,
+*   so the order is kept without ever
+*   rewriting a file. A queue that keeps
+*   up with its producers never touches
+*   the disk at all
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container. It has to
+*   be trivially copyable, the values
+*   are written to disk byte for byte
+*/
+template<typename Type>
+class SpillQueue {
+public:
+
+    static_assert(std::is_trivially_copyable<Type>::value,
+            "SpillQueue can only hold trivially copyable values");
+
+    /*
+    * @brief initializes an
+    *   empty queue object
+    *
+    * @param directory existing directory
+    *   for the segment files
+    * @param memoryBudget bytes of segments
+    *   kept in memory. At least the head
+    *   and the tail segment are kept
+    * @param segmentBytes size of a segment,
+    *   rounded down to whole values
+    */
+    explicit SpillQueue(const std::string& directory,
+            std::size_t memoryBudget = std::size_t(64) << 20,
+            std::size_t segmentBytes = std::size_t(1) << 20);
+
+    /*
+    * @brief frees the segments in memory
+    *   and removes the ones on disk
+    */
+    ~SpillQueue(void);
+
+    SpillQueue(const SpillQueue&) = delete;
+    SpillQueue& operator=(const SpillQueue&) = delete;
+
+    /*
+    * @brief adds a value
+    *   at the back of the
+    *   queue
+    *
+    * @throw std::runtime_error
+    *   if a full segment can't be
+    *   written to disk
+    *
+    * @param data value to
+    *   be added to the queue
+    */
+    void enqueue(const Type& data);
+
+    /*
+    * @brief returns a value
+    *   from the front of the
+    *   queue and deletes it
+    *   from the queue
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return value fetched from
+    *   the front of the queue
+    */
+    Type dequeue(void);
+
+    /*
+    * @brief moves the value from the
+    *   front of the queue into out if
+    *   the queue isn't empty
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the
+    *   queue is empty
+    */
+    bool tryDequeue(Type& out);
+
+    /*
+    * @brief returns a value
+    *   from the front of the
+    *   queue without deleting
+    *   it from the queue. The
+    *   segment can be a read-only
+    *   mapping, so it's const
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return reference to the front
+    *   of the queue, valid until
+    *   the next dequeue
+    */
+    const Type& first(void);
+
+    /*
+    * @brief returns a value
+    *   from the back of the
+    *   queue without deleting
+    *   it from the queue
+    *
+    * @throw std::runtime_error
+    *   if the queue is empty
+    *
+    * @return reference to the back
+    *   of the queue, valid until
+    *   the next enqueue or dequeue
+    */
+    const Type& last(void);
+
+    /*
+     * @brief returns true
+     *  if the queue is empty
+     *
+     * @return true if empty,
+     *  false otherwise
+     */
+    bool isEmpty(void);
+
+    /*
+     * @brief returns the number
+     *  of values in the queue
+     *
+     * @return value count
+     */
+    std::size_t size(void);
+
+    /*
+     * @brief returns the number
+     *  of segments on disk
+     *
+     * @return segment count
+     */
+    std::size_t spilledSegments(void);
+
+private:
+
+    /*
+     * @brief moves the head to the
+     *  next segment in queue order.
+     *  The queue must not be empty
+     */
+    void __advance_head__(void);
+
+    /*
+     * @brief moves the full tail segment
+     *  to memory or to disk and starts
+     *  a new one
+     */
+    void __retire_tail__(void);
+
+    /*
+     * @brief returns an empty segment,
+     *  reusing the spare one if there
+     *  is one
+     */
+    Type* __new_segment__(void);
+
+    /*
+     * @brief keeps a segment as the spare
+     *  one or frees it if there already
+     *  is one
+     */
+    void __release_segment__(Type* segment);
+
+    std::size_t mSegmentValues;
+    std::size_t mMaxSegments;
+    std::size_t mSize;
+
+    const Type* mHead;
+    std::size_t mHeadPos;
+    std::size_t mHeadCount;
+    Type* mHeadSegment;
+    MappedFile* mHeadFile;
+
+    Type* mTail;
+    std::size_t mTailCount;
+
+    Type* mSpare;
+    Queue<Type*> mResident;
+    SegmentSpool mSpool;
+    std::allocator<Type> mAlloc;
+
+};
+
+template<typename Type>
+SpillQueue<Type>::SpillQueue(const std::string& directory,
+        std::size_t memoryBudget, std::size_t segmentBytes) :
+    mSegmentValues(segmentBytes > sizeof(Type) ? segmentBytes / sizeof(Type) : 1),
+    mMaxSegments(0),
+    mSize(0),
+    mHead(nullptr),
+    mHeadPos(0),
+    mHeadCount(0),
+    mHeadSegment(nullptr),
+    mHeadFile(nullptr),
+    mTail(nullptr),
+    mTailCount(0),
+    mSpare(nullptr),
+    mSpool(directory)
+{
+    mMaxSegments = memoryBudget / (mSegmentValues * sizeof(Type));
+    if (mMaxSegments < 2) { mMaxSegments = 2; }
+    mTail = this->__new_segment__();
+}
+
+template<typename Type>
+SpillQueue<Type>::~SpillQueue(void) {
+    delete mHeadFile;
+    if (mHeadSegment) { mAlloc.deallocate(mHeadSegment, mSegmentValues); }
+    if (mSpare) { mAlloc.deallocate(mSpare, mSegmentValues); }
+    mAlloc.deallocate(mTail, mSegmentValues);
+    while (!mResident.isEmpty())
+        mAlloc.deallocate(mResident.dequeue(), mSegmentValues);
+}
+
+template<typename Type>
+void SpillQueue<Type>::enqueue(const Type& data) {
+    if (mTailCount == mSegmentValues) { this->__retire_tail__(); }
+    new (mTail + mTailCount++) Type(data);
+    ++mSize;
+}
+
+template<typename Type>
+Type SpillQueue<Type>::dequeue(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to dequeue an empty queue");
+    if (mHeadPos == mHeadCount) { this->__advance_head__(); }
+    --mSize;
+    return mHead[mHeadPos++];
+}
+
+template<typename Type>
+bool SpillQueue<Type>::tryDequeue(Type& out) {
+    if (!mSize) { return false; }
+    if (mHeadPos == mHeadCount) { this->__advance_head__(); }
+    --mSize;
+    out = mHead[mHeadPos++];
+    return true;
+}
+
+template<typename Type>
+const Type& SpillQueue<Type>::first(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to fetch the first element of an empty queue");
+    if (mHeadPos == mHeadCount) { this->__advance_head__(); }
+    return mHead[mHeadPos];
+}
+
+template<typename Type>
+const Type& SpillQueue<Type>::last(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to fetch the last element of an empty queue");
+
+    /*
+     * A full tail is only retired by
+     * the next enqueue, so the tail is
+     * empty only after the head took
+     * it over. The last value is then
+     * the last one of the head.
+     */
+    if (mTailCount) { return mTail[mTailCount - 1]; }
+    return mHead[mHeadCount - 1];
+}
+
+template<typename Type>
+bool SpillQueue<Type>::isEmpty(void) { return !mSize; }
+
+template<typename Type>
+std::size_t SpillQueue<Type>::size(void) { return mSize; }
+
+template<typename Type>
+std::size_t SpillQueue<Type>::spilledSegments(void) { return mSpool.count(); }
+
+template<typename Type>
+void SpillQueue<Type>::__advance_head__(void) {
+    delete mHeadFile;
+    mHeadFile = nullptr;
+    if (mHeadSegment) {
+        this->__release_segment__(mHeadSegment);
+        mHeadSegment = nullptr;
+    }
+    mHead = nullptr;
+    mHeadPos = mHeadCount = 0;
+
+    /*
+     * The segments are taken in queue
+     * order: the ones in memory, then
+     * the ones on disk, then the tail.
+     */
+    if (!mResident.isEmpty()) {
+        mHeadSegment = mResident.dequeue();
+        mHead = mHeadSegment;
+        mHeadCount = mSegmentValues;
+    } else if (mSpool.count()) {
+        mHeadFile = mSpool.next();
+        mHead = static_cast<const Type*>(mHeadFile->data());
+        mHeadCount = mHeadFile->size() / sizeof(Type);
+    } else {
+        mHeadSegment = mTail;
+        mHead = mHeadSegment;
+        mHeadCount = mTailCount;
+        mTail = this->__new_segment__();
+        mTailCount = 0;
+    }
+}
+
+template<typename Type>
+void SpillQueue<Type>::__retire_tail__(void) {
+
+    /*
+     * The head, the tail and the resident
+     * segments count against the budget.
+     * Once anything is on disk the tail
+     * has to follow it there.
+     */
+    if (!mSpool.count() && mResident.size() + 3 <= mMaxSegments) {
+        mResident.enqueue(mTail);
+        mTail = this->__new_segment__();
+    } else {
+        mSpool.append(mTail, mTailCount * sizeof(Type));
+    }
+    mTailCount = 0;
+}
+
+template<typename Type>
+Type* SpillQueue<Type>::__new_segment__(void) {
+    if (!mSpare) { return mAlloc.allocate(mSegmentValues); }
+    Type* segment = mSpare;
+    mSpare = nullptr;
+    return segment;
+}
+
+template<typename Type>
+void SpillQueue<Type>::__release_segment__(Type* segment) {
+    if (mSpare) { mAlloc.deallocate(segment, mSegmentValues); }
+    else { mSpare = segment; }
+}
+
+#endif
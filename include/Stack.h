@@ -1,48 +1,172 @@
 #ifndef STACK_H
 #define STACK_H
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
 #include <stdexcept>
-#include "ListNode.h"
+#include <type_traits>
+#include <utility>
+
+#include "ExecutionPolicy.h"
 
 /*
 * @brief Generic stack container
-*   that can store any data
-*   type by allocating memory
-*   on the heap
-* 
+*   that stores its values in a
+*   contiguous array. The first
+*   InlineCapacity values live inside
+*   the stack object itself, so small
+*   stacks never touch the heap. Beyond
+*   that the array grows geometrically
+*
 * @tparam Type The type parameter
 *   determining the type of data
 *   stored in the container
+* @tparam InlineCapacity number of
+*   values stored without allocating.
+*   By default as many as fit in 256
+*   bytes
+* @tparam Alloc allocator of the
+*   array once it leaves the
+*   inline storage
 */
-template<typename Type>
+template<typename Type, std::size_t InlineCapacity =
+    (sizeof(Type) < 256 ? 256 / sizeof(Type) : 1), typename Alloc = std::allocator<Type>>
 class Stack {
 public:
 
+    /*
+    * @brief iterator visiting the values
+    *   from the top to the bottom, in the
+    *   order they'd be popped. The values
+    *   are contiguous, so it's a plain
+    *   reversed pointer. Pushing can move
+    *   the array, which invalidates all
+    *   iterators
+    */
+    using Iterator = std::reverse_iterator<Type*>;
+    using ConstIterator = std::reverse_iterator<const Type*>;
+
     /*
     * @brief initializes an
     *   empty stack object
     */
     Stack(void);
-	
+
+    /*
+    * @brief initializes an empty
+    *   stack object that allocates
+    *   its array with the given
+    *   allocator
+    *
+    * @param alloc allocator
+    */
+    explicit Stack(const Alloc& alloc);
+
+    /*
+    * @brief destroys the remaining
+    *   values and frees the array
+    */
+    ~Stack(void);
+
+    Stack(const Stack&) = delete;
+    Stack& operator=(const Stack&) = delete;
+
     /*
     * @brief pushes a value
     *   on top of the stack
-    * 
+    *
     * @param data value to
-    *   be pushed onto the 
+    *   be pushed onto the
     *   stack
     */
-	void push(Type data);
+	void push(const Type& data);
+	void push(Type&& data);
+
+    /*
+    * @brief constructs a value
+    *   in place on top of the
+    *   stack
+    *
+    * @param args arguments passed
+    *   to the constructor of the value
+    *
+    * @return reference to the
+    *   new value
+    */
+    template<typename... Args>
+    Type& emplace(Args&&... args);
+
+    /*
+    * @brief pushes a range of values,
+    *   the last one ends up on top.
+    *   The array grows at most once
+    *   and the values are copied in
+    *   one pass, which is a memcpy for
+    *   trivially copyable types
+    *
+    * @param values values to be
+    *   pushed onto the stack
+    */
+    void pushRange(std::span<const Type> values);
+
+    /*
+    * @brief pops up to count values
+    *   into a buffer, in the order
+    *   pop would return them
+    *
+    * @param out buffer for at
+    *   least count values
+    * @param count maximum number
+    *   of values to pop
+    *
+    * @return number of values
+    *   popped, less than count if
+    *   the stack runs out
+    */
+    std::size_t popN(Type* out, std::size_t count);
+
+    /*
+    * @brief pushRange and popN with an
+    *   execution policy. With a parallel
+    *   policy trivially copyable values
+    *   are copied by the pool in chunks.
+    *   Other types and seq fall back to
+    *   the plain versions
+    *
+    * @param policy execution policy
+    */
+    void pushRange(ExecutionPolicy policy, std::span<const Type> values);
+    std::size_t popN(ExecutionPolicy policy, Type* out, std::size_t count);
+
+    /*
+    * @brief moves all of the values
+    *   out in the order pop would
+    *   return them and leaves the
+    *   stack empty
+    *
+    * @param out output iterator
+    *   receiving the values
+    *
+    * @return the output iterator
+    *   past the last value
+    */
+    template<typename OutputIt>
+    OutputIt drainTo(OutputIt out);
 
     /*
     * @brief returns the value
     *   from top of the stack
     *   and deletes it from the
     *   stack
-    * 
+    *
     * @throw std::runtime_error
     *   if the stack is empty
-    * 
+    *
     * @return value popped
     *   from the top of the
     *   stack
@@ -53,58 +177,336 @@ public:
     * @brief returns a value
     *   from top of the stack
     *   without deleting it
-    * 
+    *
     * @throw std::runtime_error
     *   if the stack is empty
-    * 
-    * @return value stored at
-    *   the top of the stack
+    *
+    * @return reference to the
+    *   top of the stack
+    */
+	Type& top(void);
+
+    /*
+    * @brief returns the value from
+    *   top of the stack without any
+    *   checks. The stack must not
+    *   be empty
+    *
+    * @return reference to the
+    *   top of the stack
     */
-	Type top(void);
+    Type& topUnchecked(void);
 
     /*
     * @brief checks if the
     *   stack is empty
-    * 
+    *
     * @return true if empty
     */
 	bool isEmpty(void);
 
+    /*
+    * @brief returns the number
+    *   of values on the stack
+    *
+    * @return value count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief makes room for the given
+    *   number of values, so that pushing
+    *   them doesn't reallocate
+    *
+    * @param capacity number of values
+    */
+    void reserve(std::size_t capacity);
+
+    /*
+    * @brief returns an iterator
+    *   to the top of the stack
+    *
+    * @return iterator to the
+    *   top value
+    */
+    Iterator begin(void);
+    ConstIterator begin(void) const;
+
+    /*
+    * @brief returns an iterator
+    *   past the bottom of the stack
+    *
+    * @return end iterator
+    */
+    Iterator end(void);
+    ConstIterator end(void) const;
+
 private:
 
-	ListNode<Type>* mHead;
+    /*
+    * @brief moves the values into
+    *   a heap array of the given
+    *   capacity
+    */
+    void __reallocate__(std::size_t capacity);
+
+    /*
+    * @brief checks if the values
+    *   are stored inline
+    */
+    bool __is_inline__(void);
+
+    using Traits = std::allocator_traits<Alloc>;
+
+    static constexpr std::size_t INLINE_SLOTS = InlineCapacity ? InlineCapacity : 1;
+
+    Type* mData;
+    std::size_t mSize;
+    std::size_t mCapacity;
+    [[no_unique_address]] Alloc mAlloc;
+    alignas(Type) unsigned char mInline[INLINE_SLOTS * sizeof(Type)];
 
 };
 
-template<typename Type>
-Stack<Type>::Stack(void) : mHead(nullptr) {}
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+Stack<Type, InlineCapacity, Alloc>::Stack(void) :
+    mData(reinterpret_cast<Type*>(mInline)),
+    mSize(0),
+    mCapacity(INLINE_SLOTS)
+{}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+Stack<Type, InlineCapacity, Alloc>::Stack(const Alloc& alloc) :
+    mData(reinterpret_cast<Type*>(mInline)),
+    mSize(0),
+    mCapacity(INLINE_SLOTS),
+    mAlloc(alloc)
+{}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+Stack<Type, InlineCapacity, Alloc>::~Stack(void) {
+    for (std::size_t i = 0; i < mSize; ++i)
+        mData[i].~Type();
+    if (!this->__is_inline__())
+        Traits::deallocate(mAlloc, mData, mCapacity);
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+void Stack<Type, InlineCapacity, Alloc>::push(const Type& data) {
+    this->emplace(data);
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+void Stack<Type, InlineCapacity, Alloc>::push(Type&& data) {
+    this->emplace(std::move(data));
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+template<typename... Args>
+Type& Stack<Type, InlineCapacity, Alloc>::emplace(Args&&... args) {
+
+    /*
+     * The arguments may refer to a value
+     * on the stack, so the new value is
+     * built before the old array goes.
+     */
+    if (mSize == mCapacity) {
+        Type data(std::forward<Args>(args)...);
+        this->__reallocate__(mCapacity * 2);
+        return *new (mData + mSize++) Type(std::move(data));
+    }
+    return *new (mData + mSize++) Type(std::forward<Args>(args)...);
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+void Stack<Type, InlineCapacity, Alloc>::pushRange(std::span<const Type> values) {
+    std::size_t count = values.size();
+    if (mSize + count <= mCapacity) {
+        std::uninitialized_copy(values.begin(), values.end(), mData + mSize);
+        mSize += count;
+        return;
+    }
+
+    /*
+     * The values may come from the stack
+     * itself, so they're copied into the
+     * new array before the old one goes.
+     */
+    std::size_t capacity = std::max(mCapacity * 2, mSize + count);
+    Type* data = Traits::allocate(mAlloc, capacity);
+    try {
+        std::uninitialized_copy(values.begin(), values.end(), data + mSize);
+    } catch (...) {
+        Traits::deallocate(mAlloc, data, capacity);
+        throw;
+    }
+
+    for (std::size_t i = 0; i < mSize; ++i) {
+        new (data + i) Type(std::move(mData[i]));
+        mData[i].~Type();
+    }
+    if (!this->__is_inline__())
+        Traits::deallocate(mAlloc, mData, mCapacity);
+    mData = data;
+    mCapacity = capacity;
+    mSize += count;
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+std::size_t Stack<Type, InlineCapacity, Alloc>::popN(Type* out, std::size_t count) {
+    count = std::min(count, mSize);
+    Type* top = mData + mSize;
+    for (std::size_t i = 0; i < count; ++i)
+        out[i] = std::move(top[-1 - static_cast<std::ptrdiff_t>(i)]);
+    std::destroy(top - count, top);
+    mSize -= count;
+    return count;
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+void Stack<Type, InlineCapacity, Alloc>::pushRange(ExecutionPolicy policy, std::span<const Type> values) {
+    if constexpr (!std::is_trivially_copyable_v<Type>) {
+        this->pushRange(values);
+    } else {
+        if (policy == ExecutionPolicy::seq) {
+            this->pushRange(values);
+            return;
+        }
+
+        std::size_t count = values.size();
+        if (mSize + count <= mCapacity) {
+            parallel_copy(policy, values.data(), count, mData + mSize);
+            mSize += count;
+            return;
+        }
+
+        /*
+         * Same order as the plain version,
+         * the values may come from the
+         * stack itself.
+         */
+        std::size_t capacity = std::max(mCapacity * 2, mSize + count);
+        Type* data = Traits::allocate(mAlloc, capacity);
+        try {
+            parallel_copy(policy, values.data(), count, data + mSize);
+            parallel_copy(policy, static_cast<const Type*>(mData), mSize, data);
+        } catch (...) {
+            Traits::deallocate(mAlloc, data, capacity);
+            throw;
+        }
 
-template<typename Type>
-void Stack<Type>::push(Type data) {
-    ListNode<Type>* newElem = new ListNode<Type>(data);
-    newElem->setNext(mHead);
-    mHead = newElem;
+        if (!this->__is_inline__())
+            Traits::deallocate(mAlloc, mData, mCapacity);
+        mData = data;
+        mCapacity = capacity;
+        mSize += count;
+    }
 }
 
-template<typename Type>
-Type Stack<Type>::pop(void) {
-    if (!mHead)
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+std::size_t Stack<Type, InlineCapacity, Alloc>::popN(ExecutionPolicy policy, Type* out, std::size_t count) {
+    if constexpr (!std::is_trivially_copyable_v<Type>) {
+        return this->popN(out, count);
+    } else {
+        if (policy == ExecutionPolicy::seq) { return this->popN(out, count); }
+        count = std::min(count, mSize);
+        parallel_reverse_copy(policy, static_cast<const Type*>(mData + mSize - count), count, out);
+        mSize -= count;
+        return count;
+    }
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+template<typename OutputIt>
+OutputIt Stack<Type, InlineCapacity, Alloc>::drainTo(OutputIt out) {
+    for (std::size_t i = mSize; i-- > 0; )
+        *out++ = std::move(mData[i]);
+    std::destroy(mData, mData + mSize);
+    mSize = 0;
+    return out;
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+Type Stack<Type, InlineCapacity, Alloc>::pop(void) {
+    if (!mSize)
         throw std::runtime_error("Tried to pop from an empty stack");
-    ListNode<Type>* tmp = mHead;
-    mHead = mHead->getNext();
-    Type data = tmp->getData();
-    delete tmp;
+    Type* slot = mData + --mSize;
+    Type data = std::move(*slot);
+    slot->~Type();
     return data;
 }
 
-template<typename Type>
-Type Stack<Type>::top(void) {
-    return mHead->getData();
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+Type& Stack<Type, InlineCapacity, Alloc>::top(void) {
+    if (!mSize)
+        throw std::runtime_error("Tried to fetch the top of an empty stack");
+    return mData[mSize - 1];
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+Type& Stack<Type, InlineCapacity, Alloc>::topUnchecked(void) {
+    return mData[mSize - 1];
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+bool Stack<Type, InlineCapacity, Alloc>::isEmpty(void) {
+    return !mSize;
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+std::size_t Stack<Type, InlineCapacity, Alloc>::size(void) {
+    return mSize;
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+typename Stack<Type, InlineCapacity, Alloc>::Iterator Stack<Type, InlineCapacity, Alloc>::begin(void) {
+    return Iterator(mData + mSize);
 }
 
-template<typename Type>
-bool Stack<Type>::isEmpty(void) {
-    return !mHead;
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+typename Stack<Type, InlineCapacity, Alloc>::Iterator Stack<Type, InlineCapacity, Alloc>::end(void) {
+    return Iterator(mData);
 }
 
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+typename Stack<Type, InlineCapacity, Alloc>::ConstIterator Stack<Type, InlineCapacity, Alloc>::begin(void) const {
+    return ConstIterator(mData + mSize);
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+typename Stack<Type, InlineCapacity, Alloc>::ConstIterator Stack<Type, InlineCapacity, Alloc>::end(void) const {
+    return ConstIterator(mData);
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+void Stack<Type, InlineCapacity, Alloc>::reserve(std::size_t capacity) {
+    if (capacity > mCapacity) { this->__reallocate__(capacity); }
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+void Stack<Type, InlineCapacity, Alloc>::__reallocate__(std::size_t capacity) {
+    Type* data = Traits::allocate(mAlloc, capacity);
+    for (std::size_t i = 0; i < mSize; ++i) {
+        new (data + i) Type(std::move(mData[i]));
+        mData[i].~Type();
+    }
+    if (!this->__is_inline__())
+        Traits::deallocate(mAlloc, mData, mCapacity);
+    mData = data;
+    mCapacity = capacity;
+}
+
+template<typename Type, std::size_t InlineCapacity, typename Alloc>
+bool Stack<Type, InlineCapacity, Alloc>::__is_inline__(void) {
+    return mData == reinterpret_cast<Type*>(mInline);
+}
+
+/*
+ * Read-only code gets the same
+ * ranges support through the
+ * const overloads.
+ */
+static_assert(std::ranges::random_access_range<Stack<int>>);
+static_assert(std::ranges::random_access_range<const Stack<int>>);
+
 #endif
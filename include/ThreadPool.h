@@ -0,0 +1,194 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ExecutionPolicy.h"
+#include "Queue.h"
+#include "WorkStealingDeque.h"
+
+class TaskGroup;
+
+/*
+* @brief Work-stealing thread pool.
+*   Every worker owns a Chase-Lev
+*   deque it pushes to and pops from
+*   at the bottom, while idle workers
+*   steal from the top of the other
+*   deques. Tasks submitted from outside
+*   of the pool go through a shared
+*   injection queue
+*/
+class ThreadPool {
+public:
+
+    /*
+    * @brief starts the worker threads
+    *
+    * @param workerCount number of
+    *   workers. 0 picks the number
+    *   of hardware threads
+    */
+    explicit ThreadPool(unsigned int workerCount = 0);
+
+    /*
+    * @brief stops and joins all of
+    *   the workers. All task groups
+    *   have to be waited for before
+    */
+    ~ThreadPool(void);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /*
+    * @brief returns the number
+    *   of worker threads
+    *
+    * @return worker count
+    */
+    unsigned int workerCount(void) const;
+
+    /*
+    * @brief returns the global pool
+    *   used by the parallel execution
+    *   policies. It's created on the
+    *   first call
+    *
+    * @return the global pool
+    */
+    static ThreadPool& instance(void);
+
+    /*
+    * @brief sets the worker count of
+    *   the global pool. Has no effect
+    *   once the global pool exists
+    *
+    * @param workerCount number of
+    *   workers. 0 picks the number
+    *   of hardware threads
+    */
+    static void setDefaultWorkerCount(unsigned int workerCount);
+
+    /*
+    * @brief checks if the calling thread
+    *   is a worker of any pool
+    *
+    * @return true on a worker thread
+    */
+    static bool isWorkerThread(void);
+
+private:
+
+    friend class TaskGroup;
+
+    /*
+    * @brief a unit of work
+    *   belonging to a task group
+    */
+    struct Task {
+        std::function<void(void)> work;
+        TaskGroup* group;
+    };
+
+    /*
+    * @brief schedules a task. Workers
+    *   push to their own deque, other
+    *   threads to the injection queue
+    */
+    void submit(Task* task);
+
+    /*
+    * @brief takes a single task from
+    *   the pool and executes it
+    *
+    * @return false if there was
+    *   nothing to execute
+    */
+    bool runOne(void);
+
+    /*
+    * @brief executes a task and
+    *   reports it to its group
+    */
+    void execute(Task* task);
+
+    void workerLoop(unsigned int idx);
+
+    std::vector<std::thread> mWorkers;
+    std::vector<WorkStealingDeque<Task*>*> mDeques;
+
+    std::mutex mInjectionMutex;
+    Queue<Task*> mInjection;
+
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondition;
+    std::atomic<std::size_t> mQueued;
+    std::atomic<unsigned int> mSleeping;
+    std::atomic<bool> mStop;
+
+};
+
+/*
+* @brief fork/join scope for tasks
+*   executed on a thread pool. The
+*   thread that waits for the group
+*   executes pending tasks instead
+*   of blocking
+*/
+class TaskGroup {
+public:
+
+    /*
+    * @brief creates an empty group
+    *
+    * @param pool pool that will
+    *   execute the tasks
+    */
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::instance());
+
+    /*
+    * @brief waits for the
+    *   remaining tasks
+    */
+    ~TaskGroup(void);
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /*
+    * @brief forks a task
+    *
+    * @param work function to be
+    *   executed by the pool
+    */
+    void run(std::function<void(void)> work);
+
+    /*
+    * @brief joins all of the forked
+    *   tasks
+    *
+    * @throw the first exception thrown
+    *   by any of the tasks
+    */
+    void wait(void);
+
+private:
+
+    friend class ThreadPool;
+
+    ThreadPool& mPool;
+    std::atomic<std::size_t> mPending;
+    std::mutex mErrorMutex;
+    std::exception_ptr mError;
+
+};
+
+#endif
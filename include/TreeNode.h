@@ -1,6 +1,8 @@
 #ifndef TREE_NODE_H
 #define TREE_NODE_H
 
+#include <utility>
+
 /*
 * @brief A generic container
 *   class that stores data
@@ -17,12 +19,24 @@ public:
 
     /*
     * @brief initialises a node
-    *   object
+    *   object, copying or moving
+    *   the initial value in
     * 
     * @param data initial value
     *   stored in the node
     */
-    TreeNode(Type data);
+    TreeNode(const Type& data);
+    TreeNode(Type&& data);
+
+    /*
+    * @brief initialises a node object
+    *   constructing the value in place
+    * 
+    * @param args arguments passed
+    *   to the constructor of the value
+    */
+    template<typename... Args>
+    explicit TreeNode(std::in_place_t, Args&&... args);
 
     /*
     * @brief sets the data
@@ -31,7 +45,8 @@ public:
     * @param data data value
     *   to be stored in the node
     */
-    void setData(Type data);
+    void setData(const Type& data);
+    void setData(Type&& data);
 
     /*
     * @brief sets the node that the
@@ -55,6 +70,17 @@ public:
     */
     void setRight(TreeNode<Type>* right);
 
+    /*
+    * @brief sets the node that the
+    *   current node's parent pointer
+    *   points to
+    *
+    * @param parent pointer to the
+    *   parent node, nullptr for
+    *   the root
+    */
+    void setParent(TreeNode<Type>* parent);
+
     /*
     * @brief returns data stored
     *   by the node
@@ -82,19 +108,48 @@ public:
     */
     TreeNode<Type>* getRight(void);
 
+    /*
+    * @brief returns a pointer
+    *   to the parent node
+    * 
+    * @return pointer to the 
+    *   parent node, nullptr for
+    *   the root
+    */
+    TreeNode<Type>* getParent(void);
+
 private:
 
 	Type mData;
 	TreeNode<Type>* mLeft;
     TreeNode<Type>* mRight;
+    TreeNode<Type>* mParent;
 
 };
 
 template<typename Type>
-TreeNode<Type>::TreeNode(Type data) : 
+TreeNode<Type>::TreeNode(const Type& data) : 
     mData(data), 
     mLeft(nullptr),
-    mRight(nullptr)
+    mRight(nullptr),
+    mParent(nullptr)
+{}
+
+template<typename Type>
+TreeNode<Type>::TreeNode(Type&& data) : 
+    mData(std::move(data)), 
+    mLeft(nullptr),
+    mRight(nullptr),
+    mParent(nullptr)
+{}
+
+template<typename Type>
+template<typename... Args>
+TreeNode<Type>::TreeNode(std::in_place_t, Args&&... args) : 
+    mData(std::forward<Args>(args)...), 
+    mLeft(nullptr),
+    mRight(nullptr),
+    mParent(nullptr)
 {}
 
 template<typename Type>
@@ -103,6 +158,9 @@ void TreeNode<Type>::setLeft(TreeNode<Type>* left) { mLeft = left; }
 template<typename Type>
 void TreeNode<Type>::setRight(TreeNode<Type>* right) { mRight = right; }
 
+template<typename Type>
+void TreeNode<Type>::setParent(TreeNode<Type>* parent) { mParent = parent; }
+
 template<typename Type>
 TreeNode<Type>* TreeNode<Type>::getLeft(void) { return mLeft; }
 
@@ -110,7 +168,13 @@ template<typename Type>
 TreeNode<Type>* TreeNode<Type>::getRight(void) { return mRight; }
 
 template<typename Type>
-void TreeNode<Type>::setData(Type data) { mData = data; }
+TreeNode<Type>* TreeNode<Type>::getParent(void) { return mParent; }
+
+template<typename Type>
+void TreeNode<Type>::setData(const Type& data) { mData = data; }
+
+template<typename Type>
+void TreeNode<Type>::setData(Type&& data) { mData = std::move(data); }
 
 template<typename Type>
 Type& TreeNode<Type>::getData(void) { return mData; }
@@ -0,0 +1,414 @@
+#ifndef UNROLLED_LIST_H
+#define UNROLLED_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "ChunkNode.h"
+
+/*
+* @brief Generic list container that
+*   stores its values in chunks of
+*   ChunkNode::CAPACITY elements.
+*   Compared to List it does one
+*   allocation per chunk instead of
+*   one per value, and traversal walks
+*   through contiguous memory most of
+*   the time
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container
+* @tparam Alloc allocator of the
+*   chunks, rebound to ChunkNode
+*/
+template<typename Type, typename Alloc = std::allocator<Type>>
+class UnrolledList {
+public:
+
+    /*
+    * @brief initialises an
+    *   empty list object
+    */
+    UnrolledList(void);
+
+    /*
+    * @brief initialises an empty
+    *   list object that allocates
+    *   its chunks with the given
+    *   allocator
+    *
+    * @param alloc allocator
+    */
+    explicit UnrolledList(const Alloc& alloc);
+
+    /*
+    * @brief destroys all of the
+    *   values and frees the chunks
+    */
+    ~UnrolledList(void);
+
+    UnrolledList(const UnrolledList&) = delete;
+    UnrolledList& operator=(const UnrolledList&) = delete;
+
+    /*
+    * @brief inserts data
+    *   at the back of the list
+    *
+    * @param data value to be
+    *   inserted into the list
+    */
+    void insert(const Type& data);
+    void insert(Type&& data);
+
+    /*
+    * @brief inserts data at the
+    *   back of the list in O(1)
+    *
+    * @param data value to be
+    *   inserted into the list
+    */
+    void pushBack(const Type& data);
+    void pushBack(Type&& data);
+
+    /*
+    * @brief inserts data at the
+    *   front of the list. Shifts
+    *   the values of the first chunk
+    *
+    * @param data value to be
+    *   inserted into the list
+    */
+    void pushFront(const Type& data);
+    void pushFront(Type&& data);
+
+    /*
+    * @brief constructs a value in
+    *   place at the back of the list
+    *
+    * @param args arguments passed
+    *   to the constructor of the value
+    *
+    * @return reference to the
+    *   new value
+    */
+    template<typename... Args>
+    Type& emplaceBack(Args&&... args);
+
+    /*
+    * @brief constructs a value in
+    *   place at the front of the list
+    *
+    * @param args arguments passed
+    *   to the constructor of the value
+    *
+    * @return reference to the
+    *   new value
+    */
+    template<typename... Args>
+    Type& emplaceFront(Args&&... args);
+
+    /*
+    * @brief removes a value
+    *   from the list
+    *
+    * @param key value to be
+    *   removed from the list. Can
+    *   be of any type comparable
+    *   with the stored values
+    */
+    template<typename Key>
+    void remove(const Key& key);
+
+    /*
+    * @brief finds a value in the list.
+    *   Chunks of arithmetic values are
+    *   compared several values at a time
+    *
+    * @param key value to search
+    *   for in the list. Can be of
+    *   any type comparable with
+    *   the stored values
+    *
+    * @return pointer to the stored
+    *   value. If there's no such
+    *   value it returns nullptr
+    */
+    template<typename Key>
+    Type* find(const Key& key);
+
+    /*
+    * @brief checks if the
+    *   list is empty
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number
+    *   of elements in the list
+    *
+    * @return element count
+    */
+    std::size_t size(void);
+
+private:
+
+    using ChunkAllocator = typename std::allocator_traits<Alloc>::template rebind_alloc<ChunkNode<Type>>;
+    using ChunkTraits = std::allocator_traits<ChunkAllocator>;
+
+    /*
+    * @brief allocates an
+    *   empty chunk
+    */
+    ChunkNode<Type>* __new_chunk__(void);
+
+    /*
+    * @brief frees a chunk. Its
+    *   values must have been
+    *   destroyed already
+    */
+    void __delete_chunk__(ChunkNode<Type>* chunk);
+
+    /*
+    * @brief searches a single chunk
+    *
+    * @return index of the key or
+    *   the chunk's count if it's
+    *   not there
+    */
+    template<typename Key>
+    static std::size_t __find_in_chunk__(ChunkNode<Type>* chunk, const Key& key);
+
+    ChunkNode<Type>* mHead;
+    ChunkNode<Type>* mTail;
+    std::size_t mSize;
+    [[no_unique_address]] ChunkAllocator mAlloc;
+
+};
+
+template<typename Type, typename Alloc>
+UnrolledList<Type, Alloc>::UnrolledList(void) : mHead(nullptr), mTail(nullptr), mSize(0) {}
+
+template<typename Type, typename Alloc>
+UnrolledList<Type, Alloc>::UnrolledList(const Alloc& alloc) :
+    mHead(nullptr),
+    mTail(nullptr),
+    mSize(0),
+    mAlloc(alloc)
+{}
+
+template<typename Type, typename Alloc>
+UnrolledList<Type, Alloc>::~UnrolledList(void) {
+    while (mHead) {
+        ChunkNode<Type>* tmp = mHead;
+        mHead = mHead->getNext();
+        for (std::size_t i = 0; i < tmp->getCount(); ++i)
+            tmp->getData()[i].~Type();
+        this->__delete_chunk__(tmp);
+    }
+}
+
+template<typename Type, typename Alloc>
+void UnrolledList<Type, Alloc>::insert(const Type& data) {
+    this->emplaceBack(data);
+}
+
+template<typename Type, typename Alloc>
+void UnrolledList<Type, Alloc>::insert(Type&& data) {
+    this->emplaceBack(std::move(data));
+}
+
+template<typename Type, typename Alloc>
+void UnrolledList<Type, Alloc>::pushBack(const Type& data) {
+    this->emplaceBack(data);
+}
+
+template<typename Type, typename Alloc>
+void UnrolledList<Type, Alloc>::pushBack(Type&& data) {
+    this->emplaceBack(std::move(data));
+}
+
+template<typename Type, typename Alloc>
+void UnrolledList<Type, Alloc>::pushFront(const Type& data) {
+    this->emplaceFront(data);
+}
+
+template<typename Type, typename Alloc>
+void UnrolledList<Type, Alloc>::pushFront(Type&& data) {
+    this->emplaceFront(std::move(data));
+}
+
+template<typename Type, typename Alloc>
+template<typename... Args>
+Type& UnrolledList<Type, Alloc>::emplaceBack(Args&&... args) {
+    if (!mTail || mTail->getCount() == ChunkNode<Type>::CAPACITY) {
+        ChunkNode<Type>* chunk = this->__new_chunk__();
+        if (!mHead) { mHead = chunk; }
+        else { mTail->setNext(chunk); }
+        mTail = chunk;
+    }
+    Type* slot = new (mTail->getData() + mTail->getCount()) Type(std::forward<Args>(args)...);
+    mTail->setCount(mTail->getCount() + 1);
+    ++mSize;
+    return *slot;
+}
+
+template<typename Type, typename Alloc>
+template<typename... Args>
+Type& UnrolledList<Type, Alloc>::emplaceFront(Args&&... args) {
+    if (!mHead || mHead->getCount() == ChunkNode<Type>::CAPACITY) {
+        ChunkNode<Type>* chunk = this->__new_chunk__();
+        chunk->setNext(mHead);
+        mHead = chunk;
+        if (!mTail) { mTail = chunk; }
+    }
+
+    /*
+     * Make room at the front of
+     * the chunk by moving every
+     * value one slot to the right.
+     * The first slot ends up
+     * moved-from and is rebuilt
+     * in place.
+     */
+    Type* values = mHead->getData();
+    std::size_t count = mHead->getCount();
+    if (count) {
+        new (values + count) Type(std::move(values[count - 1]));
+        for (std::size_t i = count - 1; i > 0; --i)
+            values[i] = std::move(values[i - 1]);
+        values[0].~Type();
+    }
+    new (values) Type(std::forward<Args>(args)...);
+    mHead->setCount(count + 1);
+    ++mSize;
+    return values[0];
+}
+
+template<typename Type, typename Alloc>
+template<typename Key>
+void UnrolledList<Type, Alloc>::remove(const Key& key) {
+    ChunkNode<Type>* prev = nullptr;
+    ChunkNode<Type>* chunk = mHead;
+    std::size_t idx = 0;
+    while (chunk && (idx = __find_in_chunk__(chunk, key)) == chunk->getCount()) {
+        prev = chunk;
+        chunk = chunk->getNext();
+    }
+    if (!chunk) return;
+
+    /*
+     * Close the gap by moving the
+     * rest of the chunk one slot to
+     * the left. The last slot ends
+     * up moved-from and is destroyed.
+     */
+    Type* values = chunk->getData();
+    std::size_t count = chunk->getCount();
+    for (std::size_t i = idx; i + 1 < count; ++i)
+        values[i] = std::move(values[i + 1]);
+    values[count - 1].~Type();
+    chunk->setCount(count - 1);
+    --mSize;
+
+    /*
+     * Free the chunk once it's
+     * empty. Half-empty chunks
+     * are left as they are.
+     */
+    if (chunk->getCount()) return;
+    if (prev) { prev->setNext(chunk->getNext()); }
+    else { mHead = chunk->getNext(); }
+    if (chunk == mTail) { mTail = prev; }
+    this->__delete_chunk__(chunk);
+}
+
+template<typename Type, typename Alloc>
+template<typename Key>
+Type* UnrolledList<Type, Alloc>::find(const Key& key) {
+    for (ChunkNode<Type>* chunk = mHead; chunk; chunk = chunk->getNext()) {
+        std::size_t idx = __find_in_chunk__(chunk, key);
+        if (idx != chunk->getCount()) { return chunk->getData() + idx; }
+    }
+    return nullptr;
+}
+
+template<typename Type, typename Alloc>
+bool UnrolledList<Type, Alloc>::isEmpty(void) {
+    return !mHead;
+}
+
+template<typename Type, typename Alloc>
+std::size_t UnrolledList<Type, Alloc>::size(void) {
+    return mSize;
+}
+
+template<typename Type, typename Alloc>
+ChunkNode<Type>* UnrolledList<Type, Alloc>::__new_chunk__(void) {
+    ChunkNode<Type>* chunk = ChunkTraits::allocate(mAlloc, 1);
+    ChunkTraits::construct(mAlloc, chunk);
+    return chunk;
+}
+
+template<typename Type, typename Alloc>
+void UnrolledList<Type, Alloc>::__delete_chunk__(ChunkNode<Type>* chunk) {
+    ChunkTraits::destroy(mAlloc, chunk);
+    ChunkTraits::deallocate(mAlloc, chunk, 1);
+}
+
+template<typename Type, typename Alloc>
+template<typename Key>
+std::size_t UnrolledList<Type, Alloc>::__find_in_chunk__(ChunkNode<Type>* chunk, const Key& key) {
+    const Type* values = chunk->getData();
+    std::size_t count = chunk->getCount();
+    std::size_t i = 0;
+
+    if constexpr (std::is_integral_v<Type> && sizeof(Type) == 4 && std::is_same_v<Key, Type>) {
+#if defined(__SSE2__)
+
+        /*
+         * Compare four values at a time
+         * and only look at the single
+         * values once a block matched.
+         */
+        __m128i needle = _mm_set1_epi32(static_cast<int>(key));
+        for (; i + 4 <= count; i += 4) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, needle)));
+            if (mask) { return i + __builtin_ctz(mask); }
+        }
+#endif
+    } else if constexpr (std::is_arithmetic_v<Type> && std::is_arithmetic_v<Key>) {
+
+        /*
+         * Without intrinsics check whole
+         * blocks without branching, which
+         * the compiler can vectorise, and
+         * only look at the single values
+         * once a block matched.
+         */
+        constexpr std::size_t BLOCK = 16 / sizeof(Type) ? 16 / sizeof(Type) : 1;
+        for (; i + BLOCK <= count; i += BLOCK) {
+            bool hit = false;
+            for (std::size_t j = 0; j < BLOCK; ++j)
+                hit |= values[i + j] == key;
+            if (hit) { break; }
+        }
+    }
+
+    while (i < count && values[i] != key)
+        ++i;
+    return i;
+}
+
+#endif
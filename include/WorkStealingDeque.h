@@ -0,0 +1,298 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/*
+* @brief Chase-Lev work-stealing deque.
+*   A single owner thread pushes and pops
+*   at the bottom without locks or CAS
+*   (except when it races for the last
+*   value), while any number of thieves
+*   steal from the top with a CAS. The
+*   owner works in LIFO order, which keeps
+*   recursive tasks hot in its cache, and
+*   the thieves take the oldest, usually
+*   biggest, pieces of work.
+*
+*   The circular array doubles when the
+*   owner fills it up. A thief may still
+*   be reading the old array, so the old
+*   arrays are only freed together with
+*   the deque, which costs at most as much
+*   memory as the current array.
+*
+*   The memory orders follow Le, Pop, Cohen
+*   and Zappa Nardelli, "Correct and
+*   Efficient Work-Stealing for Weak Memory
+*   Models" (PPoPP 2013), with acquire in
+*   place of consume
+*
+* @tparam Type The type parameter
+*   determining the type of data
+*   stored in the container. It has to
+*   be trivially copyable, usually it's
+*   a pointer to a task
+*/
+template<typename Type>
+class WorkStealingDeque {
+public:
+
+    static_assert(std::is_trivially_copyable<Type>::value,
+            "WorkStealingDeque can only hold trivially copyable values");
+
+    /*
+    * @brief initializes an
+    *   empty deque object
+    *
+    * @param capacity initial capacity,
+    *   rounded up to a power of two
+    */
+    explicit WorkStealingDeque(std::size_t capacity = 64);
+
+    /*
+    * @brief frees the arrays. No
+    *   thread may use the deque
+    *   anymore
+    */
+    ~WorkStealingDeque(void);
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /*
+    * @brief adds a value at the bottom
+    *   of the deque, growing the array
+    *   if it's full. Owner thread only
+    *
+    * @param data value to be
+    *   added to the deque
+    */
+    void push(Type data);
+
+    /*
+    * @brief takes the value from the
+    *   bottom of the deque. Owner
+    *   thread only
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the
+    *   deque is empty
+    */
+    bool pop(Type& out);
+
+    /*
+    * @brief takes the value from the
+    *   top of the deque. Can be called
+    *   by any thread
+    *
+    * @param out destination
+    *   of the value
+    *
+    * @return false if the deque is
+    *   empty or another thread took
+    *   the value first
+    */
+    bool steal(Type& out);
+
+    /*
+    * @brief checks if the deque is
+    *   empty. The answer may be stale
+    *   by the time it's returned
+    *
+    * @return true if empty
+    */
+    bool isEmpty(void);
+
+    /*
+    * @brief returns the number of values
+    *   in the deque. The answer may be
+    *   stale by the time it's returned
+    *
+    * @return value count
+    */
+    std::size_t size(void);
+
+    /*
+    * @brief returns the capacity
+    *   of the current array
+    *
+    * @return capacity
+    */
+    std::size_t capacity(void);
+
+private:
+
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    /*
+    * @brief circular array indexed
+    *   by the unbounded top and
+    *   bottom positions
+    */
+    struct Buffer {
+        explicit Buffer(std::int64_t capacity) :
+            mask(capacity - 1),
+            slots(new std::atomic<Type>[capacity])
+        {}
+
+        ~Buffer(void) { delete[] slots; }
+
+        Type get(std::int64_t pos) {
+            return slots[pos & mask].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t pos, Type data) {
+            slots[pos & mask].store(data, std::memory_order_relaxed);
+        }
+
+        std::int64_t mask;
+        std::atomic<Type>* slots;
+    };
+
+    /*
+    * @brief copies the values into an
+    *   array twice as large and publishes
+    *   it. Owner thread only
+    *
+    * @return the new array
+    */
+    Buffer* __grow__(Buffer* buffer, std::int64_t top, std::int64_t bottom);
+
+    alignas(CACHE_LINE) std::atomic<std::int64_t> mTop;
+    alignas(CACHE_LINE) std::atomic<std::int64_t> mBottom;
+    std::atomic<Buffer*> mBuffer;
+    std::vector<Buffer*> mRetired;
+
+};
+
+template<typename Type>
+WorkStealingDeque<Type>::WorkStealingDeque(std::size_t capacity) : mTop(0), mBottom(0) {
+    std::int64_t rounded = 2;
+    while (static_cast<std::size_t>(rounded) < capacity)
+        rounded <<= 1;
+    mBuffer.store(new Buffer(rounded), std::memory_order_relaxed);
+}
+
+template<typename Type>
+WorkStealingDeque<Type>::~WorkStealingDeque(void) {
+    delete mBuffer.load(std::memory_order_relaxed);
+    for (auto buffer : mRetired)
+        delete buffer;
+}
+
+template<typename Type>
+void WorkStealingDeque<Type>::push(Type data) {
+    std::int64_t bottom = mBottom.load(std::memory_order_relaxed);
+    std::int64_t top = mTop.load(std::memory_order_acquire);
+    Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+
+    if (bottom - top > buffer->mask)
+        buffer = this->__grow__(buffer, top, bottom);
+
+    /*
+     * The release fence makes the value
+     * visible before the new bottom, so
+     * a thief that sees the bottom also
+     * sees the value.
+     */
+    buffer->put(bottom, data);
+    std::atomic_thread_fence(std::memory_order_release);
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template<typename Type>
+bool WorkStealingDeque<Type>::pop(Type& out) {
+    std::int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+    mBottom.store(bottom, std::memory_order_relaxed);
+
+    /*
+     * The owner and the thieves each
+     * write one index and read the other.
+     * The full fence orders the bottom
+     * store before the top load, so they
+     * can't both take the same value.
+     */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t top = mTop.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        mBottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    out = buffer->get(bottom);
+    if (top < bottom) { return true; }
+
+    /*
+     * This is the last value,
+     * race the thieves for it.
+     */
+    bool won = mTop.compare_exchange_strong(top, top + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+template<typename Type>
+bool WorkStealingDeque<Type>::steal(Type& out) {
+    std::int64_t top = mTop.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t bottom = mBottom.load(std::memory_order_acquire);
+
+    if (top >= bottom) { return false; }
+
+    /*
+     * Read the value before claiming
+     * it. Once the CAS succeeds the
+     * owner may overwrite the slot.
+     */
+    Buffer* buffer = mBuffer.load(std::memory_order_acquire);
+    Type data = buffer->get(top);
+    if (!mTop.compare_exchange_strong(top, top + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+
+    out = data;
+    return true;
+}
+
+template<typename Type>
+bool WorkStealingDeque<Type>::isEmpty(void) {
+    std::int64_t bottom = mBottom.load(std::memory_order_relaxed);
+    std::int64_t top = mTop.load(std::memory_order_relaxed);
+    return bottom <= top;
+}
+
+template<typename Type>
+std::size_t WorkStealingDeque<Type>::size(void) {
+    std::int64_t bottom = mBottom.load(std::memory_order_relaxed);
+    std::int64_t top = mTop.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+}
+
+template<typename Type>
+std::size_t WorkStealingDeque<Type>::capacity(void) {
+    return static_cast<std::size_t>(mBuffer.load(std::memory_order_relaxed)->mask + 1);
+}
+
+template<typename Type>
+typename WorkStealingDeque<Type>::Buffer* WorkStealingDeque<Type>::__grow__(
+        Buffer* buffer, std::int64_t top, std::int64_t bottom) {
+    Buffer* grown = new Buffer((buffer->mask + 1) * 2);
+    for (std::int64_t pos = top; pos < bottom; ++pos)
+        grown->put(pos, buffer->get(pos));
+
+    mRetired.push_back(buffer);
+    mBuffer.store(grown, std::memory_order_release);
+    return grown;
+}
+
+#endif
@@ -1,11 +1,24 @@
 #include <iostream>
+#include <chrono>
+#include <charconv>
 #include <cstdlib>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
 
 #include "List.h"
 #include "Stack.h"
 #include "Queue.h"
 #include "Sorting.h"
 #include "BST.h"
+#include "Benchmarks.h"
+#include "MappedFile.h"
+#include "ScratchBuffer.h"
 
 static constexpr unsigned short ARR_LENGTH = 10;
 static constexpr unsigned int MAX_VAL = 20; 
@@ -165,8 +178,291 @@ void BSTDemo(void) {
     else { std::cout << "The tree is empty\n"; }
 }
 
-int main(void) {
-    //dataStructuresDemo();
-    //sortingDemo();
-    BSTDemo();
+/*
+ * Size of the buffer used to 
+ * format the text output before 
+ * handing it to the kernel.
+ */
+static constexpr std::size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+void print_usage(void) {
+    std::cout <<
+        "Usage:\n"
+        "  DEMO demo\n"
+        "  DEMO <algorithm> <input> [options]\n"
+        "  DEMO bench <name>\n"
+        "\n"
+        "Algorithms: merge, quick, heap, counting, radix, none\n"
+        "  radix only supports non-negative values\n"
+        "\n"
+        "Options:\n"
+        "  --text            input is whitespace separated text,\n"
+        "                    native binary int32 otherwise\n"
+        "  --in-place        sort the binary input file itself\n"
+        "  --output <path>   write the sorted values to a file\n"
+        "  --output-text     write the output as text\n"
+        "  --parallel        use the parallel execution policy\n"
+        "  --threads <n>     number of worker threads\n"
+        "  --plain-scratch   don't use huge pages or pre-faulting\n"
+        "                    for the sorting scratch buffers\n"
+        "  --bst             build a BST from the input values\n";
+}
+
+/*
+ * @brief writes the whole buffer, 
+ *  retrying on partial writes
+ */
+bool write_all(int fd, const char* data, std::size_t size) {
+    while (size) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) { return false; }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+/*
+ * @brief parses whitespace separated 
+ *  integers from a text file mapping
+ */
+std::vector<int> parse_text(const char* begin, const char* end) {
+    std::vector<int> values;
+    values.reserve(static_cast<std::size_t>(end - begin) / 4);
+    while (begin < end) {
+        while (begin < end && (*begin == ' ' || *begin == '\t' 
+                    || *begin == '\r' || *begin == '\n'))
+            ++begin;
+        if (begin == end) { break; }
+        int value = 0;
+        auto result = std::from_chars(begin, end, value);
+        if (result.ec != std::errc())
+            throw std::runtime_error("Invalid integer in the input file");
+        values.push_back(value);
+        begin = result.ptr;
+    }
+    return values;
+}
+
+/*
+ * @brief writes the values to a file, 
+ *  either straight from memory or 
+ *  formatted as text in large chunks
+ */
+void write_values(const std::string& path, const int* values, 
+        std::size_t count, bool text) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Failed to open " + path);
+
+    bool ok = true;
+    if (!text) {
+
+        /*
+         * Binary output is written 
+         * in a single call straight 
+         * from the sorted buffer.
+         */
+        ok = write_all(fd, reinterpret_cast<const char*>(values), count * sizeof(int));
+    } else {
+        std::vector<char> buffer(WRITE_BUFFER_SIZE);
+        std::size_t used = 0;
+        for (std::size_t i = 0; i < count && ok; ++i) {
+
+            /*
+             * Flush the buffer when 
+             * the longest possible 
+             * int might not fit in it.
+             */
+            if (buffer.size() - used < 16) {
+                ok = write_all(fd, buffer.data(), used);
+                used = 0;
+            }
+            auto result = std::to_chars(buffer.data() + used, 
+                    buffer.data() + buffer.size(), values[i]);
+            used = static_cast<std::size_t>(result.ptr - buffer.data());
+            buffer[used++] = '\n';
+        }
+        ok = ok && write_all(fd, buffer.data(), used);
+    }
+
+    ::close(fd);
+    if (!ok)
+        throw std::runtime_error("Failed to write " + path);
+}
+
+int run_cli(int argc, char** argv) {
+    using Clock = std::chrono::steady_clock;
+
+    std::string_view algorithm = argv[1];
+    std::string input = argv[2], output;
+    bool text = false, inPlace = false, outputText = false, buildBst = false;
+    ExecutionPolicy policy = ExecutionPolicy::seq;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--text") { text = true; }
+        else if (arg == "--in-place") { inPlace = true; }
+        else if (arg == "--output-text") { outputText = true; }
+        else if (arg == "--parallel") { policy = ExecutionPolicy::par; }
+        else if (arg == "--bst") { buildBst = true; }
+        else if (arg == "--plain-scratch") { ScratchBuffer::configure(false, false); }
+        else if (arg == "--output" && i + 1 < argc) { output = argv[++i]; }
+        else if (arg == "--threads" && i + 1 < argc) {
+            ThreadPool::setDefaultWorkerCount(std::stoul(argv[++i]));
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (inPlace && text) {
+        std::cerr << "--in-place only works with binary input\n";
+        return 1;
+    }
+
+    if (algorithm != "merge" && algorithm != "quick" && algorithm != "heap" 
+            && algorithm != "counting" && algorithm != "radix" && algorithm != "none") {
+        std::cerr << "Unknown algorithm " << algorithm << "\n";
+        print_usage();
+        return 1;
+    }
+
+    /*
+     * Prints the time elapsed and 
+     * the page faults taken since 
+     * the last report.
+     */
+    struct rusage initial;
+    ::getrusage(RUSAGE_SELF, &initial);
+    long minorFaults = initial.ru_minflt, majorFaults = initial.ru_majflt;
+    auto report = [&](const char* phase, Clock::time_point start) {
+        auto now = Clock::now();
+        std::chrono::duration<double, std::milli> elapsed = now - start;
+
+        struct rusage usage;
+        ::getrusage(RUSAGE_SELF, &usage);
+        std::cout << phase << ":\t" << elapsed.count() << " ms\t" 
+            << usage.ru_minflt - minorFaults << " minor / " 
+            << usage.ru_majflt - majorFaults << " major faults\n";
+        minorFaults = usage.ru_minflt;
+        majorFaults = usage.ru_majflt;
+        return now;
+    };
+
+    /*
+     * Load phase. Binary input is sorted 
+     * right on the mapping. A private 
+     * mapping leaves the file untouched, 
+     * a shared one writes the result back 
+     * to it. Text input has to be parsed 
+     * into a separate array.
+     */
+    auto start = Clock::now();
+    MappedFile file(input, text ? MappedFile::Mode::Read
+            : inPlace ? MappedFile::Mode::Shared : MappedFile::Mode::Private);
+    file.adviseSequential();
+
+    std::vector<int> parsed;
+    int* values = nullptr;
+    std::size_t count = 0;
+    if (text) {
+        const char* begin = static_cast<const char*>(file.data());
+        parsed = parse_text(begin, begin + file.size());
+        values = parsed.data();
+        count = parsed.size();
+    } else {
+        if (file.size() % sizeof(int))
+            throw std::runtime_error("Binary input size is not a multiple of 4 bytes");
+        values = static_cast<int*>(file.data());
+        count = file.size() / sizeof(int);
+    }
+    std::cout << "values:\t" << count << "\n";
+
+    /*
+     * The sorts index with int, a 
+     * larger count would wrap.
+     */
+    if (count > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+        throw std::runtime_error("Input has " + std::to_string(count) 
+                + " values, the sorts take at most " 
+                + std::to_string(std::numeric_limits<int>::max()));
+
+    /*
+     * Radix sorts by the raw bits,
+     * a negative value would land
+     * after the positive ones.
+     */
+    if (algorithm == "radix") {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (values[i] < 0)
+                throw std::runtime_error("Input has a negative value "
+                        + std::to_string(values[i]) + " at index " + std::to_string(i)
+                        + ", radix only supports non-negative values");
+        }
+    }
+    start = report("load", start);
+
+    /*
+     * The tree is built from the 
+     * input order, as the sorted 
+     * order would degenerate it 
+     * into a list.
+     */
+    if (buildBst) {
+        BST<int> bst;
+        for (std::size_t i = 0; i < count; ++i)
+            bst.insert(values[i]);
+        start = report("bst", start);
+    }
+
+    int size = static_cast<int>(count);
+    if (size) {
+        if (algorithm == "merge") { merge_sort(policy, values, 0, size - 1); }
+        else if (algorithm == "quick") { quick_sort(policy, values, 0, size - 1); }
+        else if (algorithm == "heap") { heap_sort(policy, values, size); }
+        else if (algorithm == "counting") { counting_sort(policy, values, size); }
+        else if (algorithm == "radix") { radix_sort(policy, values, size); }
+    }
+    start = report("sort", start);
+
+    if (!output.empty()) {
+        write_values(output, values, count, outputText);
+        report("write", start);
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv) {
+
+    /*
+     * Without arguments or with 
+     * "demo" run the toy demos.
+     */
+    if (argc < 2 || std::string_view(argv[1]) == "demo") {
+        //dataStructuresDemo();
+        //sortingDemo();
+        BSTDemo();
+        return 0;
+    }
+
+    if (argc < 3) {
+        print_usage();
+        return 1;
+    }
+
+    if (std::string_view(argv[1]) == "bench") {
+        if (run_benchmark(argv[2])) { return 0; }
+        std::cerr << "Unknown benchmark, available benchmarks:\n";
+        list_benchmarks();
+        return 1;
+    }
+
+    try {
+        return run_cli(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
 }
@@ -0,0 +1,122 @@
+#include "HazardPointers.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+/*
+ * Retired nodes are scanned once 
+ * a thread has collected this 
+ * many of them.
+ */
+static constexpr std::size_t RECLAIM_THRESHOLD = 2 * HazardPointers::MAX_THREADS;
+
+/*
+ * @brief a node waiting for deletion
+ */
+struct Retired {
+    void* pointer;
+    void (*deleter)(void*);
+};
+
+/*
+ * @brief a hazard slot. Padded to a 
+ *  cache line, as every thread writes 
+ *  its own slot on each protect.
+ */
+struct alignas(64) HazardSlot {
+    std::atomic<void*> pointer{nullptr};
+    std::atomic<bool> owned{false};
+};
+
+static HazardSlot sSlots[HazardPointers::MAX_THREADS];
+
+/*
+ * Nodes retired by threads that 
+ * exited before they could free them.
+ */
+static std::mutex sOrphanMutex;
+static std::vector<Retired> sOrphans;
+
+/*
+ * @brief frees every node of the list 
+ *  that isn't protected by any slot 
+ *  and keeps the rest
+ */
+static void __reclaim__(std::vector<Retired>& retired) {
+    std::vector<void*> hazards;
+    for (auto& slot : sSlots) {
+        void* pointer = slot.pointer.load(std::memory_order_seq_cst);
+        if (pointer) { hazards.push_back(pointer); }
+    }
+    std::sort(hazards.begin(), hazards.end());
+
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < retired.size(); ++i) {
+        if (std::binary_search(hazards.begin(), hazards.end(), retired[i].pointer))
+            retired[kept++] = retired[i];
+        else
+            retired[i].deleter(retired[i].pointer);
+    }
+    retired.resize(kept);
+}
+
+/*
+ * @brief per thread state. Takes a 
+ *  slot on the first use and gives 
+ *  it back when the thread exits.
+ */
+struct HazardRecord {
+    HazardSlot* slot = nullptr;
+    std::vector<Retired> retired;
+
+    ~HazardRecord(void) {
+        if (slot) { slot->pointer.store(nullptr); }
+        __reclaim__(retired);
+        if (!retired.empty()) {
+            std::lock_guard<std::mutex> lock(sOrphanMutex);
+            sOrphans.insert(sOrphans.end(), retired.begin(), retired.end());
+        }
+        if (slot) { slot->owned.store(false, std::memory_order_release); }
+    }
+};
+
+static thread_local HazardRecord tRecord;
+
+std::atomic<void*>& HazardPointers::__slot__(void) {
+    if (tRecord.slot) { return tRecord.slot->pointer; }
+
+    for (auto& slot : sSlots) {
+        bool expected = false;
+        if (!slot.owned.load(std::memory_order_relaxed) &&
+            slot.owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            tRecord.slot = &slot;
+            return slot.pointer;
+        }
+    }
+    throw std::runtime_error("Ran out of hazard pointer slots");
+}
+
+void HazardPointers::clear(void) {
+    if (tRecord.slot) { tRecord.slot->pointer.store(nullptr, std::memory_order_release); }
+}
+
+void HazardPointers::retire(void* pointer, void (*deleter)(void*)) {
+    tRecord.retired.push_back({ pointer, deleter });
+    if (tRecord.retired.size() < RECLAIM_THRESHOLD) { return; }
+
+    /*
+     * Adopt the nodes left behind by 
+     * exited threads, so they don't 
+     * stay around forever.
+     */
+    {
+        std::unique_lock<std::mutex> lock(sOrphanMutex, std::try_to_lock);
+        if (lock.owns_lock() && !sOrphans.empty()) {
+            tRecord.retired.insert(tRecord.retired.end(), sOrphans.begin(), sOrphans.end());
+            sOrphans.clear();
+        }
+    }
+    __reclaim__(tRecord.retired);
+}
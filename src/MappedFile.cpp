@@ -0,0 +1,60 @@
+#include "MappedFile.h"
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path, Mode mode) :
+    mData(nullptr),
+    mSize(0)
+{
+    int fd = ::open(path.c_str(), mode == Mode::Shared ? O_RDWR : O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Failed to open " + path);
+
+    struct stat info;
+    if (::fstat(fd, &info) < 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat " + path);
+    }
+    mSize = static_cast<std::size_t>(info.st_size);
+
+    /*
+     * Mapping zero bytes is an
+     * error, so an empty file is
+     * just left without a mapping.
+     */
+    if (mSize) {
+        int prot = mode == Mode::Read ? PROT_READ : PROT_READ | PROT_WRITE;
+        int flags = mode == Mode::Shared ? MAP_SHARED : MAP_PRIVATE;
+        mData = ::mmap(nullptr, mSize, prot, flags, fd, 0);
+        if (mData == MAP_FAILED) {
+            mData = nullptr;
+            ::close(fd);
+            throw std::runtime_error("Failed to map " + path);
+        }
+    }
+
+    /*
+     * The mapping keeps its own
+     * reference to the file.
+     */
+    ::close(fd);
+}
+
+MappedFile::~MappedFile(void) {
+    if (mData) { ::munmap(mData, mSize); }
+}
+
+void* MappedFile::data(void) { return mData; }
+
+std::size_t MappedFile::size(void) const { return mSize; }
+
+void MappedFile::adviseSequential(void) {
+    if (!mData) { return; }
+    ::madvise(mData, mSize, MADV_SEQUENTIAL);
+    ::madvise(mData, mSize, MADV_WILLNEED);
+}
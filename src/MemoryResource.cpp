@@ -0,0 +1,184 @@
+#include "MemoryResource.h"
+
+#include <cstdint>
+
+/*
+ * Every chunk starts with a header
+ * that links it to the previous
+ * chunk. The header takes a whole
+ * cache line, so the memory after
+ * it keeps the chunk alignment.
+ */
+static constexpr std::size_t CHUNK_ALIGN = 64;
+
+struct ChunkHeader {
+    void* next;
+    std::size_t size;
+};
+
+static_assert(sizeof(ChunkHeader) <= CHUNK_ALIGN, "Chunk header doesn't fit a cache line");
+
+/*
+ * @brief gives a list of
+ *  chunks back to upstream
+ */
+static void __free_chunks__(void* chunk, std::pmr::memory_resource* upstream) {
+    while (chunk) {
+        ChunkHeader* header = static_cast<ChunkHeader*>(chunk);
+        void* next = header->next;
+        upstream->deallocate(chunk, header->size, CHUNK_ALIGN);
+        chunk = next;
+    }
+}
+
+PoolResource::PoolResource(std::size_t blockSize, std::size_t blocksPerChunk,
+        std::pmr::memory_resource* upstream) :
+    mUpstream(upstream),
+    mBlocksPerChunk(blocksPerChunk ? blocksPerChunk : 1),
+    mFree(nullptr),
+    mChunks(nullptr)
+{
+
+    /*
+     * A free block has to hold the
+     * free-list link. The blocks follow
+     * each other in the chunk, so every
+     * block is aligned to the largest
+     * power of two dividing the block
+     * size, up to the chunk alignment.
+     */
+    std::size_t align = alignof(std::max_align_t);
+    if (blockSize < sizeof(FreeBlock)) { blockSize = sizeof(FreeBlock); }
+    mBlockSize = (blockSize + align - 1) / align * align;
+    mBlockAlign = mBlockSize & (~mBlockSize + 1);
+    if (mBlockAlign > CHUNK_ALIGN) { mBlockAlign = CHUNK_ALIGN; }
+}
+
+PoolResource::~PoolResource(void) {
+    this->release();
+}
+
+void PoolResource::release(void) {
+    __free_chunks__(mChunks, mUpstream);
+    mChunks = nullptr;
+    mFree = nullptr;
+}
+
+std::size_t PoolResource::blockSize(void) const {
+    return mBlockSize;
+}
+
+void* PoolResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    if (bytes > mBlockSize || alignment > mBlockAlign)
+        return mUpstream->allocate(bytes, alignment);
+
+    if (!mFree) { this->__refill__(); }
+    FreeBlock* block = mFree;
+    mFree = block->next;
+    return block;
+}
+
+void PoolResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+    if (bytes > mBlockSize || alignment > mBlockAlign) {
+        mUpstream->deallocate(pointer, bytes, alignment);
+        return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    block->next = mFree;
+    mFree = block;
+}
+
+bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void PoolResource::__refill__(void) {
+    std::size_t size = CHUNK_ALIGN + mBlockSize * mBlocksPerChunk;
+    void* chunk = mUpstream->allocate(size, CHUNK_ALIGN);
+    ChunkHeader* header = static_cast<ChunkHeader*>(chunk);
+    header->next = mChunks;
+    header->size = size;
+    mChunks = chunk;
+
+    /*
+     * Link the blocks back to front,
+     * so they're handed out in address
+     * order.
+     */
+    char* blocks = static_cast<char*>(chunk) + CHUNK_ALIGN;
+    for (std::size_t i = mBlocksPerChunk; i-- > 0; ) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(blocks + i * mBlockSize);
+        block->next = mFree;
+        mFree = block;
+    }
+}
+
+ArenaResource::ArenaResource(std::size_t initialSize, std::pmr::memory_resource* upstream) :
+    mUpstream(upstream),
+    mInitialSize(initialSize > CHUNK_ALIGN ? initialSize : 2 * CHUNK_ALIGN),
+    mNextSize(mInitialSize),
+    mAllocated(0),
+    mCursor(nullptr),
+    mEnd(nullptr),
+    mChunks(nullptr)
+{}
+
+ArenaResource::~ArenaResource(void) {
+    this->release();
+}
+
+void ArenaResource::release(void) {
+    __free_chunks__(mChunks, mUpstream);
+    mChunks = nullptr;
+    mCursor = mEnd = nullptr;
+    mNextSize = mInitialSize;
+    mAllocated = 0;
+}
+
+std::size_t ArenaResource::allocated(void) const {
+    return mAllocated;
+}
+
+void* ArenaResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(mCursor);
+    std::uintptr_t aligned = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+
+    if (!mCursor || aligned + bytes > reinterpret_cast<std::uintptr_t>(mEnd)) {
+        this->__grow__(bytes, alignment);
+        cursor = reinterpret_cast<std::uintptr_t>(mCursor);
+        aligned = (cursor + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    }
+
+    mCursor = reinterpret_cast<char*>(aligned + bytes);
+    mAllocated += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void ArenaResource::do_deallocate(void*, std::size_t, std::size_t) {}
+
+bool ArenaResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void ArenaResource::__grow__(std::size_t bytes, std::size_t alignment) {
+
+    /*
+     * The new chunk has to fit the
+     * request even in the worst case
+     * of alignment padding.
+     */
+    std::size_t needed = CHUNK_ALIGN + bytes + (alignment > CHUNK_ALIGN ? alignment : 0);
+    while (mNextSize < needed)
+        mNextSize *= 2;
+
+    void* chunk = mUpstream->allocate(mNextSize, CHUNK_ALIGN);
+    ChunkHeader* header = static_cast<ChunkHeader*>(chunk);
+    header->next = mChunks;
+    header->size = mNextSize;
+    mChunks = chunk;
+
+    mCursor = static_cast<char*>(chunk) + CHUNK_ALIGN;
+    mEnd = static_cast<char*>(chunk) + mNextSize;
+    mNextSize *= 2;
+}
@@ -0,0 +1,210 @@
+#include "ScratchBuffer.h"
+
+#include <atomic>
+#include <limits>
+#include <new>
+
+#include <sys/mman.h>
+
+#include "ThreadPool.h"
+
+/*
+ * Buffers of at least this size are
+ * mapped from the kernel in whole huge
+ * pages. Smaller ones come from the heap.
+ */
+static constexpr std::size_t LARGE_BUFFER = std::size_t(2) << 20;
+
+/*
+ * Number of released buffers
+ * kept by a single thread.
+ */
+static constexpr int CACHE_SLOTS = 4;
+
+static std::atomic<bool> sHugePages{true};
+static std::atomic<bool> sPopulate{true};
+
+/*
+ * Bytes a single pool worker may keep
+ * cached. Every worker has its own
+ * cache, so without a limit a multi-GB
+ * sort would leave its buffers resident
+ * in all of them. Other threads are
+ * only bounded by the slot count, so
+ * the thread driving the sorts keeps
+ * reusing even the largest buffers.
+ */
+static std::atomic<std::size_t> sCacheLimit{std::size_t(64) << 20};
+
+static void* __allocate__(std::size_t capacity) {
+    if (capacity < LARGE_BUFFER)
+        return ::operator new(capacity);
+
+    bool hugePages = sHugePages.load(std::memory_order_relaxed);
+    bool populate = sPopulate.load(std::memory_order_relaxed);
+
+    /*
+     * Without huge pages the kernel can 
+     * pre-fault the mapping right away.
+     */
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if (populate && !hugePages) { flags |= MAP_POPULATE; }
+    void* data = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (data == MAP_FAILED)
+        throw std::bad_alloc();
+
+    if (!hugePages) { return data; }
+
+    /*
+     * The huge page advice only affects 
+     * pages that weren't faulted in yet, 
+     * so pre-faulting has to come after it.
+     * Kernels without MADV_POPULATE_WRITE 
+     * get every page touched instead.
+     */
+    ::madvise(data, capacity, MADV_HUGEPAGE);
+    if (populate) {
+#ifdef MADV_POPULATE_WRITE
+        if (::madvise(data, capacity, MADV_POPULATE_WRITE) == 0) { return data; }
+#endif
+        volatile char* bytes = static_cast<char*>(data);
+        for (std::size_t i = 0; i < capacity; i += 4096)
+            bytes[i] = 0;
+    }
+    return data;
+}
+
+static void __free__(void* data, std::size_t capacity) {
+    if (capacity < LARGE_BUFFER) { ::operator delete(data); }
+    else { ::munmap(data, capacity); }
+}
+
+/*
+ * @brief per thread cache of the
+ *  released buffers. Frees them
+ *  when the thread exits.
+ */
+struct ScratchCache {
+    void* data[CACHE_SLOTS] = {};
+    std::size_t capacity[CACHE_SLOTS] = {};
+    std::size_t bytes = 0;
+
+    ~ScratchCache(void) { this->clear(); }
+
+    void release(int slot) {
+        __free__(data[slot], capacity[slot]);
+        bytes -= capacity[slot];
+        data[slot] = nullptr;
+        capacity[slot] = 0;
+    }
+
+    void clear(void) {
+        for (int i = 0; i < CACHE_SLOTS; ++i) {
+            if (data[i]) { this->release(i); }
+        }
+    }
+};
+
+static thread_local ScratchCache tCache;
+
+ScratchBuffer::ScratchBuffer(std::size_t bytes) : mData(nullptr), mCapacity(0) {
+
+    /*
+     * Take the smallest cached
+     * buffer that is big enough.
+     */
+    int best = -1;
+    for (int i = 0; i < CACHE_SLOTS; ++i) {
+        if (!tCache.data[i] || tCache.capacity[i] < bytes) { continue; }
+        if (best < 0 || tCache.capacity[i] < tCache.capacity[best]) { best = i; }
+    }
+    if (best >= 0) {
+        mData = tCache.data[best];
+        mCapacity = tCache.capacity[best];
+        tCache.bytes -= mCapacity;
+        tCache.data[best] = nullptr;
+        tCache.capacity[best] = 0;
+        return;
+    }
+
+    /*
+     * Otherwise allocate a new one.
+     * Large buffers are rounded up
+     * to whole huge pages, small ones
+     * to a cache line.
+     */
+    if (bytes >= LARGE_BUFFER) {
+        mCapacity = (bytes + LARGE_BUFFER - 1) & ~(LARGE_BUFFER - 1);
+    } else {
+        mCapacity = (bytes + 63) & ~std::size_t(63);
+        if (!mCapacity) { mCapacity = 64; }
+    }
+    mData = __allocate__(mCapacity);
+}
+
+ScratchBuffer::~ScratchBuffer(void) {
+
+    /*
+     * A buffer over the limit is
+     * never cached at all.
+     */
+    std::size_t limit = ThreadPool::isWorkerThread()
+        ? sCacheLimit.load(std::memory_order_relaxed)
+        : std::numeric_limits<std::size_t>::max();
+    if (mCapacity > limit) {
+        __free__(mData, mCapacity);
+        return;
+    }
+
+    /*
+     * Put the buffer into an empty
+     * slot, or in place of the smallest
+     * cached one if it's bigger.
+     */
+    int smallest = 0;
+    for (int i = 0; i < CACHE_SLOTS; ++i) {
+        if (!tCache.data[i]) {
+            smallest = i;
+            break;
+        }
+        if (tCache.capacity[i] < tCache.capacity[smallest]) { smallest = i; }
+    }
+
+    if (tCache.data[smallest]) {
+        if (tCache.capacity[smallest] >= mCapacity) {
+            __free__(mData, mCapacity);
+            return;
+        }
+        tCache.release(smallest);
+    }
+
+    /*
+     * Make room under the limit by
+     * dropping the smaller buffers
+     * first, the big ones are the
+     * expensive ones to fault in again.
+     */
+    while (tCache.bytes > limit - mCapacity) {
+        int victim = -1;
+        for (int i = 0; i < CACHE_SLOTS; ++i) {
+            if (!tCache.data[i]) { continue; }
+            if (victim < 0 || tCache.capacity[i] < tCache.capacity[victim]) { victim = i; }
+        }
+        tCache.release(victim);
+    }
+
+    tCache.data[smallest] = mData;
+    tCache.capacity[smallest] = mCapacity;
+    tCache.bytes += mCapacity;
+}
+
+void ScratchBuffer::configure(bool hugePages, bool populate) {
+    sHugePages.store(hugePages);
+    sPopulate.store(populate);
+}
+
+void ScratchBuffer::setCacheLimit(std::size_t bytes) {
+    sCacheLimit.store(bytes);
+}
+
+void ScratchBuffer::releaseCached(void) { tCache.clear(); }
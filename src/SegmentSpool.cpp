@@ -0,0 +1,93 @@
+#include "SegmentSpool.h"
+
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+ * Tells apart the spools of one 
+ * process sharing a directory. 
+ * The pid tells apart processes.
+ */
+static std::atomic<std::uint64_t> sSpoolCount{0};
+
+SegmentSpool::SegmentSpool(const std::string& directory) :
+    mPrefix(directory + "/spool-" + std::to_string(::getpid()) + "-" 
+        + std::to_string(sSpoolCount.fetch_add(1)) + "-"),
+    mFirst(0),
+    mEnd(0),
+    mPrefetched(nullptr)
+{}
+
+SegmentSpool::~SegmentSpool(void) {
+    delete mPrefetched;
+    for (std::uint64_t segment = mFirst; segment < mEnd; ++segment)
+        ::unlink(this->__path__(segment).c_str());
+}
+
+void SegmentSpool::append(const void* data, std::size_t size) {
+    std::string path = this->__path__(mEnd);
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0)
+        throw std::runtime_error("Failed to create " + path);
+
+    /*
+     * A write can be cut short by a 
+     * signal or a full pipe, so keep 
+     * going until all of it is out.
+     */
+    const char* bytes = static_cast<const char*>(data);
+    while (size) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) { continue; }
+            ::close(fd);
+            ::unlink(path.c_str());
+            throw std::runtime_error("Failed to write " + path);
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+
+    ::close(fd);
+    ++mEnd;
+}
+
+MappedFile* SegmentSpool::next(void) {
+    MappedFile* file = mPrefetched ? mPrefetched : this->__map__(mFirst);
+    mPrefetched = nullptr;
+    ++mFirst;
+
+    /*
+     * Start reading the next segment 
+     * in the background while the 
+     * caller works through this one. 
+     * It's only a hint, if it fails 
+     * the next call maps it again 
+     * and reports the error.
+     */
+    if (mFirst < mEnd) {
+        try { mPrefetched = this->__map__(mFirst); }
+        catch (const std::runtime_error&) {}
+    }
+    return file;
+}
+
+std::size_t SegmentSpool::count(void) const {
+    return static_cast<std::size_t>(mEnd - mFirst);
+}
+
+MappedFile* SegmentSpool::__map__(std::uint64_t segment) {
+    std::string path = this->__path__(segment);
+    MappedFile* file = new MappedFile(path, MappedFile::Mode::Read);
+    ::unlink(path.c_str());
+    file->adviseSequential();
+    return file;
+}
+
+std::string SegmentSpool::__path__(std::uint64_t segment) const {
+    return mPrefix + std::to_string(segment) + ".seg";
+}
@@ -1,10 +1,25 @@
 #include "Sorting.h"
+#include "Heap.h"
+#include "ScratchBuffer.h"
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <vector>
 
 #define _DBG std::cout <<
 #define _ARRDBG(arr, start, end) for(int i = start; i < end + 1; ++i) { std::cout << arr[i] << " "; }
 
+/*
+ * Ranges shorter than this are 
+ * sorted sequentially even with 
+ * a parallel policy, as forking 
+ * them would cost more than it saves.
+ */
+static constexpr int PARALLEL_CUTOFF = 1 << 14;
+
+static void __merge__(int* arr, const int& lptr, const int& mid, const int& rptr);
+
 void merge_sort(int* arr, const int& lptr, const int& rptr) {
 
     /*
@@ -13,7 +28,7 @@ void merge_sort(int* arr, const int& lptr, const int& rptr) {
      * If not, return from the 
      * function.
      */
-    if (lptr == rptr) { return; }
+    if (lptr >= rptr) { return; }
 
     /*
      * Find the midpoint of the 
@@ -29,6 +44,15 @@ void merge_sort(int* arr, const int& lptr, const int& rptr) {
     merge_sort(arr, lptr, mid);
     merge_sort(arr, mid + 1, rptr);
 
+    /*
+     * Merge both of the 
+     * sorted halves.
+     */
+    __merge__(arr, lptr, mid, rptr);
+}
+
+static void __merge__(int* arr, const int& lptr, const int& mid, const int& rptr) {
+
     /*
      * Initialize temporary buffer 
      * for sorting. Left and right 
@@ -43,7 +67,8 @@ void merge_sort(int* arr, const int& lptr, const int& rptr) {
      * both halves.
      */
     int left = lptr, right = mid + 1, sptr = 0;
-    int* sorted = new int[rptr - lptr + 1];
+    ScratchBuffer buffer(sizeof(int) * (rptr - lptr + 1));
+    int* sorted = buffer.as<int>();
 
     /*
      * Start merging both halves 
@@ -91,24 +116,17 @@ void merge_sort(int* arr, const int& lptr, const int& rptr) {
      */
     for (int i = lptr; i < rptr + 1; ++i)
         arr[i] = sorted[i - lptr];
-
-    /*
-     * Cleanup!
-     */
-    delete[] sorted;
 }
 
-void quick_sort(int* arr, const int& lptr, const int& rptr) {
-
-    /*
-     * Check if the range of the 
-     * indexes makes sense. If the 
-     * length of the array is equal 
-     * to 1 or the left index is 
-     * greater than the right index 
-     * then return from the function.
-     */
-    if (lptr >= rptr) { return; }
+/*
+ * @brief partitions the array around 
+ *  the value stored under the rightmost 
+ *  index. Shared by quick_sort and 
+ *  IncrementalSort.
+ *
+ * @return final index of the pivot
+ */
+static int __partition__(int* arr, const int& lptr, const int& rptr) {
 
     /*
      * Initialize additional indexes 
@@ -157,11 +175,15 @@ void quick_sort(int* arr, const int& lptr, const int& rptr) {
         if (left >= right) { break; }
 
         /*
-         * Otherwise swap their values. 
+         * Otherwise swap their values 
+         * and step over both of them. 
+         * Without the step two values 
+         * equal to the pivot would be 
+         * swapped back and forth forever.
          */
         int tmp = arr[left];
-        arr[left] = arr[right];
-        arr[right] = tmp;
+        arr[left++] = arr[right];
+        arr[right--] = tmp;
     }
 
     /*
@@ -181,6 +203,27 @@ void quick_sort(int* arr, const int& lptr, const int& rptr) {
     arr[rptr] = arr[left];
     arr[left] = pivot;
 
+    return left;
+}
+
+void quick_sort(int* arr, const int& lptr, const int& rptr) {
+
+    /*
+     * Check if the range of the 
+     * indexes makes sense. If the 
+     * length of the array is equal 
+     * to 1 or the left index is 
+     * greater than the right index 
+     * then return from the function.
+     */
+    if (lptr >= rptr) { return; }
+
+    /*
+     * Partition the array. The pivot 
+     * lands in its final spot.
+     */
+    int pivot = __partition__(arr, lptr, rptr);
+
     /*
      * Recursively call quick_sort
      * for left and the right half 
@@ -189,53 +232,25 @@ void quick_sort(int* arr, const int& lptr, const int& rptr) {
      * already in the correct spot 
      * and doesn't need further sorting.
      */
-    quick_sort(arr, lptr, left - 1);
-    quick_sort(arr, left + 1, rptr);
+    quick_sort(arr, lptr, pivot - 1);
+    quick_sort(arr, pivot + 1, rptr);
 
 }
 
 void heap_sort(int* arr, const int& arrSize) {
 
     /*
-     * Initialize the heap.
-     */
-    int* heap = new int[arrSize];
-    int heapPtr = 0;
-
-    /*
-     * Here I will build the 
-     * heap following the rule
+     * Build the heap right inside 
+     * the array, following the rule 
      * that every parent has two 
-     * children and every child 
-     * has to be smaller than
-     * its parent.
+     * children and no child can be 
+     * greater than its parent. The 
+     * sifting logic lives in Heap.h, 
+     * as the priority queues use it 
+     * too.
      */
-    for (int i = 0; i < arrSize; ++i) {
-
-        /*
-         * First, insert data
-         * at the very back
-         * of the heap.
-         */
-        int idx = heapPtr++;
-        heap[idx] = arr[i];
-
-        /*
-         * Then bring the node
-         * up the data tree until 
-         * it is smaller than its 
-         * parent and greater than 
-         * its children.
-         */
-        while (idx > 0) {
-            int parentIdx = (idx - 1) / 2;
-            if (heap[idx] < heap[parentIdx]) { break; } //all good
-            int tmp = heap[parentIdx];
-            heap[parentIdx] = heap[idx];
-            heap[idx] = tmp;
-            idx = parentIdx;
-        }
-    }
+    auto less = [](const int& a, const int& b) { return a < b; };
+    heap_make(arr, arrSize, less);
 
     /*
      * Here's the sorting logic. In 
@@ -247,60 +262,25 @@ void heap_sort(int* arr, const int& arrSize) {
      * remaining nodes to keep the 
      * integrity of the data structure.
      */
-    for (int i = 0; i < arrSize; ++i) {
-        
+    for (int heapSize = arrSize - 1; heapSize > 0; --heapSize) {
+
         /* 
-         * Swap the first and the last 
-         * nodes. I will use the heapPtr 
-         * from before to point to the 
-         * last free space in the array 
-         * that is not a part of the heap.
+         * Swap the first node with the 
+         * last node of the heap. The last 
+         * spot then stops being a part of 
+         * the heap.
          */
-        int tmp = heap[0];
-        heap[0] = heap[--heapPtr];
-        heap[heapPtr] = tmp;
-        
+        int tmp = arr[0];
+        arr[0] = arr[heapSize];
+        arr[heapSize] = tmp;
+
         /* 
          * Pull the first node down the
-         * list by continuously swapping 
-         * it with its greatest child. The 
-         * loop stops when the node doesn't 
-         * have any children or both of its 
-         * children are smaller.
+         * heap by continuously swapping 
+         * it with its greatest child.
          */
-        int idx = 0;
-        while(2 * idx + 1 < heapPtr) {
-            int lIdx = 2 * idx + 1;
-            int rIdx = lIdx + 1;
-            int maxIdx = 0;
-            if (rIdx < heapPtr &&
-                heap[rIdx] > heap[lIdx]) {
-                maxIdx = rIdx;
-            } else {
-                maxIdx = lIdx;
-            }
-            if (heap[idx] < heap[maxIdx]) {
-                tmp = heap[idx];
-                heap[idx] = heap[maxIdx];
-                heap[maxIdx] = tmp;
-                idx = maxIdx;
-            } else { break; }
-        }
+        heap_sift_down(arr, heapSize, 0, less);
     }
-
-    /*
-     * Overwrite the original array 
-     * with the data taken from the 
-     * sorted heap.
-     */
-    for(int i = 0; i < arrSize; ++i)
-        arr[i] = heap[i];
-
-    /*
-     * Cleanup!
-     */
-    delete[] heap; 
-
 }
 
 void counting_sort(int* arr, const int& arrSize) {
@@ -332,7 +312,8 @@ void counting_sort(int* arr, const int& arrSize) {
      *  We also offset by minimum value 
      *  for the reasons given above.
      */
-    int* count = new int[max - min + 1];
+    ScratchBuffer buffer(sizeof(int) * (static_cast<std::size_t>(max) - min + 1));
+    int* count = buffer.as<int>();
     for (int i = min; i < max + 1; ++i) 
         count[i - min] = 0;
 
@@ -366,12 +347,6 @@ void counting_sort(int* arr, const int& arrSize) {
         --count[cntidx];
     }
 
-    /*
-     * Don't forget to cleanup
-     * after ourselves!
-     */
-    delete[] count;
-
 }
 
 void radix_sort(int* arr, const int& arrSize) {
@@ -385,8 +360,9 @@ void radix_sort(int* arr, const int& arrSize) {
      * will be the destination buffer
      * that I'll be writing into.
      */
-    int* preSort = new int[arrSize];
-    int* postSort = new int[arrSize];
+    ScratchBuffer preBuffer(sizeof(int) * arrSize), postBuffer(sizeof(int) * arrSize);
+    int* preSort = preBuffer.as<int>();
+    int* postSort = postBuffer.as<int>();
     for (int i = 0; i < arrSize; ++i)
         preSort[i] = postSort[i] = arr[i];
 
@@ -413,7 +389,17 @@ void radix_sort(int* arr, const int& arrSize) {
      */
     int shift = 0;
 
-    while (true) {
+    /*
+     * OR all of the values together 
+     * to find the highest set bit. 
+     * There's no point in sorting 
+     * by the bits above it.
+     */
+    unsigned int bits = 0;
+    for (int i = 0; i < arrSize; ++i)
+        bits |= static_cast<unsigned int>(arr[i]);
+
+    while (shift < 32 && (bits >> shift)) {
         
         /*
          * This temporary count array
@@ -435,15 +421,6 @@ void radix_sort(int* arr, const int& arrSize) {
             else { ++count[0]; }
         }
 
-        /*
-         * If all numbers have 0 on the
-         * ith position, that means that
-         * we have shifted beyond the range
-         * of the whole set, so there's no
-         * more sorting to be done.
-         */
-        if (count[0] == arrSize) { break; } //sorted
-
         /*
          * The position array is a concept
          * specific to radix sort. It stores
@@ -493,10 +470,265 @@ void radix_sort(int* arr, const int& arrSize) {
     for (int i = 0; i < arrSize; ++i)
         arr[i] = preSort[i];
 
+}
+
+IncrementalSort::IncrementalSort(int* arr, const int& arrSize) :
+    mArr(arr),
+    mSize(arrSize),
+    mIdx(0)
+{
+    /*
+     * The stack holds indexes of 
+     * pivots that are already in 
+     * their final spots, the smallest 
+     * one on top. The size of the 
+     * array acts as a sentinel pivot 
+     * that closes the whole range.
+     */
+    mPivots.push(arrSize);
+}
+
+bool IncrementalSort::hasNext(void) { return mIdx < mSize; }
+
+int IncrementalSort::next(void) {
+    if (mIdx >= mSize)
+        throw std::runtime_error("Tried to fetch past the end of an incremental sort");
+
+    /*
+     * Keep partitioning the unsorted 
+     * range that starts at the next 
+     * index to be returned until the 
+     * next index itself becomes a pivot.
+     * Ranges to the right of the top 
+     * pivot are left untouched, which 
+     * is what makes the first k elements 
+     * cost O(n + k log k) on average.
+     */
+    while (mPivots.topUnchecked() != mIdx) {
+        int rptr = mPivots.topUnchecked() - 1;
+
+        /*
+         * Take the middle value as the 
+         * pivot, so that already sorted 
+         * input doesn't degrade into 
+         * quadratic time.
+         */
+        int mid = mIdx + (rptr - mIdx) / 2;
+        int tmp = mArr[mid];
+        mArr[mid] = mArr[rptr];
+        mArr[rptr] = tmp;
+
+        mPivots.push(__partition__(mArr, mIdx, rptr));
+    }
+
+    /*
+     * The next index is in its final 
+     * spot, so it won't be needed as 
+     * a boundary anymore.
+     */
+    mPivots.pop();
+    return mArr[mIdx++];
+}
+
+void merge_sort(ExecutionPolicy policy, int* arr, const int& lptr, const int& rptr) {
+
+    /*
+     * Sort the short ranges 
+     * and the sequential calls 
+     * without forking.
+     */
+    if (policy == ExecutionPolicy::seq || rptr - lptr < PARALLEL_CUTOFF) {
+        merge_sort(arr, lptr, rptr);
+        return;
+    }
+
+    /*
+     * Fork the left half and sort 
+     * the right one on this thread.
+     * The group is joined before 
+     * the halves get merged.
+     */
+    int mid = (lptr + rptr) / 2;
+    TaskGroup group;
+    group.run([=] { merge_sort(policy, arr, lptr, mid); });
+    merge_sort(policy, arr, mid + 1, rptr);
+    group.wait();
+
+    __merge__(arr, lptr, mid, rptr);
+}
+
+void quick_sort(ExecutionPolicy policy, int* arr, const int& lptr, const int& rptr) {
+    if (policy == ExecutionPolicy::seq || rptr - lptr < PARALLEL_CUTOFF) {
+        quick_sort(arr, lptr, rptr);
+        return;
+    }
+
+    /*
+     * Both sides of the pivot are 
+     * independent, so the left side 
+     * can be sorted by another worker.
+     */
+    int pivot = __partition__(arr, lptr, rptr);
+    TaskGroup group;
+    group.run([=] { quick_sort(policy, arr, lptr, pivot - 1); });
+    quick_sort(policy, arr, pivot + 1, rptr);
+    group.wait();
+}
+
+void heap_sort(ExecutionPolicy policy, int* arr, const int& arrSize) {
+
+    /*
+     * Every step depends on the 
+     * previous one, so there's 
+     * nothing to parallelise.
+     */
+    (void)policy;
+    heap_sort(arr, arrSize);
+}
+
+void counting_sort(ExecutionPolicy policy, int* arr, const int& arrSize) {
+    if (policy == ExecutionPolicy::seq || arrSize < PARALLEL_CUTOFF) {
+        counting_sort(arr, arrSize);
+        return;
+    }
+
+    /*
+     * Find the range of the values 
+     * with one task per chunk. Each 
+     * chunk has its own slot, so no 
+     * synchronisation is needed.
+     */
+    std::size_t chunks = ThreadPool::instance().workerCount() * 4;
+    std::size_t step = (arrSize + chunks - 1) / chunks;
+    std::vector<int> mins(chunks, arr[0]), maxs(chunks, arr[0]);
+    parallel_for(policy, 0, chunks, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t c = lo; c < hi; ++c) {
+            std::size_t end = std::min<std::size_t>(arrSize, (c + 1) * step);
+            for (std::size_t i = c * step; i < end; ++i) {
+                mins[c] = mins[c] < arr[i] ? mins[c] : arr[i];
+                maxs[c] = maxs[c] > arr[i] ? maxs[c] : arr[i];
+            }
+        }
+    }, 1);
+    int min = *std::min_element(mins.begin(), mins.end());
+    int max = *std::max_element(maxs.begin(), maxs.end());
+
+    /*
+     * The counting itself has to go 
+     * to a single array. Counting 
+     * into one array per chunk would 
+     * multiply the memory by the number 
+     * of chunks, so only do it when the 
+     * range is small compared to the array.
+     */
+    std::size_t range = static_cast<std::size_t>(max) - min + 1;
+    if (range * chunks > static_cast<std::size_t>(arrSize)) {
+        counting_sort(arr, arrSize);
+        return;
+    }
+
+    std::vector<int> count(range * chunks, 0);
+    parallel_for(policy, 0, chunks, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t c = lo; c < hi; ++c) {
+            std::size_t end = std::min<std::size_t>(arrSize, (c + 1) * step);
+            int* local = count.data() + c * range;
+            for (std::size_t i = c * step; i < end; ++i)
+                ++local[arr[i] - min];
+        }
+    }, 1);
+
+    /*
+     * Sum the chunk counts up 
+     * and fill the array back 
+     * like the sequential version.
+     */
+    int arridx = 0;
+    for (std::size_t v = 0; v < range; ++v) {
+        int total = 0;
+        for (std::size_t c = 0; c < chunks; ++c)
+            total += count[c * range + v];
+        for (int i = 0; i < total; ++i)
+            arr[arridx++] = static_cast<int>(v) + min;
+    }
+}
+
+void radix_sort(ExecutionPolicy policy, int* arr, const int& arrSize) {
+    if (policy == ExecutionPolicy::seq || arrSize < PARALLEL_CUTOFF) {
+        radix_sort(arr, arrSize);
+        return;
+    }
+
     /*
-     * Cleanup!
+     * Same algorithm as the sequential 
+     * version, but both the counting and 
+     * the scattering are split into chunks.
+     * Each chunk scatters into its own 
+     * window of the output, which keeps 
+     * the sort stable.
      */
-    delete[] preSort;
-    delete[] postSort;
+    std::size_t chunks = ThreadPool::instance().workerCount() * 4;
+    std::size_t step = (arrSize + chunks - 1) / chunks;
+    std::vector<int> zeros(chunks), zeroPos(chunks), onePos(chunks);
+
+    ScratchBuffer preBuffer(sizeof(int) * arrSize), postBuffer(sizeof(int) * arrSize);
+    int* preSort = preBuffer.as<int>();
+    int* postSort = postBuffer.as<int>();
+    parallel_for(policy, 0, arrSize, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i)
+            preSort[i] = arr[i];
+    });
+
+    unsigned int bits = 0;
+    for (int i = 0; i < arrSize; ++i)
+        bits |= static_cast<unsigned int>(arr[i]);
+
+    for (int shift = 0; shift < 32 && (bits >> shift); ++shift) {
+
+        parallel_for(policy, 0, chunks, [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t c = lo; c < hi; ++c) {
+                std::size_t end = std::min<std::size_t>(arrSize, (c + 1) * step);
+                int cnt = 0;
+                for (std::size_t i = c * step; i < end; ++i)
+                    cnt += !((preSort[i] >> shift) & 0b1);
+                zeros[c] = cnt;
+            }
+        }, 1);
+
+        /*
+         * Zeros of chunk c go after the 
+         * zeros of all previous chunks, 
+         * ones go after all of the zeros 
+         * and the ones of previous chunks.
+         */
+        int totalZeros = 0;
+        for (std::size_t c = 0; c < chunks; ++c)
+            totalZeros += zeros[c];
+        int zeroAcc = 0;
+        for (std::size_t c = 0; c < chunks; ++c) {
+            int begin = static_cast<int>(std::min<std::size_t>(arrSize, c * step));
+            zeroPos[c] = zeroAcc;
+            onePos[c] = totalZeros + (begin - zeroAcc);
+            zeroAcc += zeros[c];
+        }
+
+        parallel_for(policy, 0, chunks, [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t c = lo; c < hi; ++c) {
+                std::size_t end = std::min<std::size_t>(arrSize, (c + 1) * step);
+                int zp = zeroPos[c], op = onePos[c];
+                for (std::size_t i = c * step; i < end; ++i) {
+                    if ((preSort[i] >> shift) & 0b1) { postSort[op++] = preSort[i]; }
+                    else { postSort[zp++] = preSort[i]; }
+                }
+            }
+        }, 1);
+
+        int* tmp = preSort;
+        preSort = postSort;
+        postSort = tmp;
+    }
 
+    parallel_for(policy, 0, arrSize, [&](std::size_t lo, std::size_t hi) {
+        for (std::size_t i = lo; i < hi; ++i)
+            arr[i] = preSort[i];
+    });
 }
@@ -0,0 +1,249 @@
+#include "ThreadPool.h"
+
+/*
+ * Worker threads remember which
+ * pool they belong to and which
+ * deque is theirs, so that tasks
+ * forked from within a task land
+ * on the local deque.
+ */
+static thread_local ThreadPool* tCurrentPool = nullptr;
+static thread_local unsigned int tWorkerIdx = 0;
+
+static std::atomic<unsigned int> sDefaultWorkerCount{0};
+
+/*
+ * Initial capacity of the worker
+ * deques. They grow if deep recursion
+ * forks more tasks than that.
+ */
+static constexpr std::size_t DEQUE_CAPACITY = 1024;
+
+ThreadPool::ThreadPool(unsigned int workerCount) :
+    mQueued(0),
+    mSleeping(0),
+    mStop(false)
+{
+    if (!workerCount) { workerCount = std::thread::hardware_concurrency(); }
+    if (!workerCount) { workerCount = 1; }
+
+    /*
+     * Create all of the deques before
+     * starting any of the workers, as
+     * they steal from each other.
+     */
+    for (unsigned int i = 0; i < workerCount; ++i)
+        mDeques.push_back(new WorkStealingDeque<Task*>(DEQUE_CAPACITY));
+    for (unsigned int i = 0; i < workerCount; ++i)
+        mWorkers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool(void) {
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStop.store(true);
+    }
+    mSleepCondition.notify_all();
+    for (auto& worker : mWorkers)
+        worker.join();
+    for (auto deque : mDeques)
+        delete deque;
+}
+
+unsigned int ThreadPool::workerCount(void) const {
+    return static_cast<unsigned int>(mDeques.size());
+}
+
+ThreadPool& ThreadPool::instance(void) {
+    static ThreadPool pool(sDefaultWorkerCount.load());
+    return pool;
+}
+
+void ThreadPool::setDefaultWorkerCount(unsigned int workerCount) {
+    sDefaultWorkerCount.store(workerCount);
+}
+
+bool ThreadPool::isWorkerThread(void) { return tCurrentPool != nullptr; }
+
+void ThreadPool::submit(Task* task) {
+    mQueued.fetch_add(1);
+
+    /*
+     * Tasks forked by a worker go to its
+     * own deque. Everything else goes
+     * through the injection queue.
+     */
+    if (tCurrentPool == this) {
+        mDeques[tWorkerIdx]->push(task);
+    } else {
+        std::lock_guard<std::mutex> lock(mInjectionMutex);
+        mInjection.enqueue(task);
+    }
+
+    /*
+     * Wake a sleeping worker up. The
+     * worker checks mQueued under the
+     * same mutex before it goes to sleep,
+     * so the wakeup can't get lost.
+     */
+    if (mSleeping.load()) {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mSleepCondition.notify_one();
+    }
+}
+
+bool ThreadPool::runOne(void) {
+    Task* task = nullptr;
+    unsigned int count = this->workerCount();
+    unsigned int self = tCurrentPool == this ? tWorkerIdx : 0;
+
+    /*
+     * Prefer the local deque, as
+     * its tasks are still hot in
+     * the cache.
+     */
+    if (tCurrentPool == this)
+        mDeques[self]->pop(task);
+
+    /*
+     * Then the tasks
+     * submitted from outside.
+     */
+    if (!task && mQueued.load()) {
+        std::lock_guard<std::mutex> lock(mInjectionMutex);
+        if (!mInjection.isEmpty())
+            task = mInjection.dequeue();
+    }
+
+    /*
+     * Finally try to steal from
+     * the other workers.
+     */
+    for (unsigned int i = 1; !task && i <= count; ++i)
+        mDeques[(self + i) % count]->steal(task);
+
+    if (!task) { return false; }
+
+    mQueued.fetch_sub(1);
+    this->execute(task);
+    return true;
+}
+
+void ThreadPool::execute(Task* task) {
+    TaskGroup* group = task->group;
+
+    try {
+        task->work();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(group->mErrorMutex);
+        if (!group->mError) { group->mError = std::current_exception(); }
+    }
+
+    delete task;
+    group->mPending.fetch_sub(1, std::memory_order_release);
+}
+
+void ThreadPool::workerLoop(unsigned int idx) {
+    tCurrentPool = this;
+    tWorkerIdx = idx;
+
+    while (!mStop.load()) {
+        if (this->runOne()) { continue; }
+
+        /*
+         * Spin for a while before going
+         * to sleep, so that short gaps
+         * between tasks don't cost
+         * a wakeup.
+         */
+        bool found = false;
+        for (int i = 0; i < 64 && !found; ++i) {
+            std::this_thread::yield();
+            found = mQueued.load() != 0;
+        }
+        if (found) { continue; }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleeping.fetch_add(1);
+        mSleepCondition.wait(lock, [this] {
+            return mStop.load() || mQueued.load() != 0;
+        });
+        mSleeping.fetch_sub(1);
+    }
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : mPool(pool), mPending(0) {}
+
+TaskGroup::~TaskGroup(void) {
+
+    /*
+     * The tasks reference the group,
+     * so it can't go away before them.
+     * Errors are dropped here, as
+     * destructors can't throw.
+     */
+    while (mPending.load(std::memory_order_acquire))
+        if (!mPool.runOne()) { std::this_thread::yield(); }
+}
+
+void TaskGroup::run(std::function<void(void)> work) {
+    mPending.fetch_add(1, std::memory_order_relaxed);
+    mPool.submit(new ThreadPool::Task{ std::move(work), this });
+}
+
+void TaskGroup::wait(void) {
+
+    /*
+     * Help the pool instead of
+     * blocking. This is what keeps
+     * nested fork/join from running
+     * out of workers.
+     */
+    while (mPending.load(std::memory_order_acquire))
+        if (!mPool.runOne()) { std::this_thread::yield(); }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mErrorMutex);
+        error = mError;
+        mError = nullptr;
+    }
+    if (error) { std::rethrow_exception(error); }
+}
+
+void parallel_for(ExecutionPolicy policy, std::size_t begin, std::size_t end,
+        const std::function<void(std::size_t lo, std::size_t hi)>& body,
+        std::size_t grain) {
+
+    if (begin >= end) { return; }
+    if (!grain) { grain = 1; }
+
+    /*
+     * Run inline if the caller asked
+     * for it or if the range is too
+     * short to be worth splitting.
+     */
+    std::size_t length = end - begin;
+    if (policy == ExecutionPolicy::seq || length <= grain) {
+        body(begin, end);
+        return;
+    }
+
+    /*
+     * Cut the range into a few chunks
+     * per worker, so that stealing can
+     * balance uneven chunks.
+     */
+    ThreadPool& pool = ThreadPool::instance();
+    std::size_t chunks = (length + grain - 1) / grain;
+    std::size_t maxChunks = static_cast<std::size_t>(pool.workerCount()) * 4;
+    if (chunks > maxChunks) { chunks = maxChunks; }
+    std::size_t step = (length + chunks - 1) / chunks;
+
+    TaskGroup group(pool);
+    for (std::size_t lo = begin; lo < end; lo += step) {
+        std::size_t hi = end - lo < step ? end : lo + step;
+        group.run([&body, lo, hi] { body(lo, hi); });
+    }
+    group.wait();
+}